@@ -534,6 +534,11 @@ struct MVMREPROps_Positional {
 
     MVMint64 (*read_buf) (MVMThreadContext *tc, MVMSTable *st,
         MVMObject *root, void *data, MVMint64 offset, MVMuint64 elems);
+
+    /* Returns a true value if there is an element at the specified index,
+     * and a false one if not. */
+    MVMint64 (*exists_pos) (MVMThreadContext *tc, MVMSTable *st,
+        MVMObject *root, void *data, MVMint64 index);
 };
 struct MVMREPROps_Associative {
     /* Gets the value at the specified key and places it in the passed
@@ -564,6 +564,7 @@ static void string_consts(MVMThreadContext *tc) {
     string_creator(P6opaque, "P6opaque");
     string_creator(box_target, "box_target");
     string_creator(array, "array");
+    string_creator(inthash, "inthash");
     string_creator(positional_delegate, "positional_delegate");
     string_creator(associative_delegate, "associative_delegate");
     string_creator(auto_viv_container, "auto_viv_container");
@@ -668,6 +669,7 @@ void MVM_6model_bootstrap(MVMThreadContext *tc) {
     create_stub_boot_type(tc, MVM_REPR_ID_MVMCapture, boot_types.BOOTCapture, 0, MVM_BOOL_MODE_NOT_TYPE_OBJECT);
     create_stub_boot_type(tc, MVM_REPR_ID_MVMTracked, boot_types.BOOTTracked, 0, MVM_BOOL_MODE_NOT_TYPE_OBJECT);
     create_stub_boot_type(tc, MVM_REPR_ID_MVMStat, boot_types.BOOTStat, 0, MVM_BOOL_MODE_NOT_TYPE_OBJECT);
+    create_stub_boot_type(tc, MVM_REPR_ID_MVMStringBuilder, boot_types.BOOTStringBuilder, 0, MVM_BOOL_MODE_NOT_TYPE_OBJECT);
 
     /* Bootstrap the KnowHOW type, giving it a meta-object. */
     bootstrap_KnowHOW(tc);
@@ -705,6 +707,7 @@ void MVM_6model_bootstrap(MVMThreadContext *tc) {
     meta_objectifier(tc, boot_types.BOOTCapture, "BOOTCapture");
     meta_objectifier(tc, boot_types.BOOTTracked, "BOOTTracked");
     meta_objectifier(tc, boot_types.BOOTStat, "BOOTStat");
+    meta_objectifier(tc, boot_types.BOOTStringBuilder, "BOOTStringBuilder");
 
     /* Create the KnowHOWAttribute type. */
     create_KnowHOWAttribute(tc);
@@ -152,6 +152,14 @@ GCC_DIAG_ON(return-type)
 void MVM_REPR_DEFAULT_SPLICE(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *target_array, MVMint64 offset, MVMuint64 elems) {
     die_no_pos(tc, st->REPR->name, MVM_6model_get_stable_debug_name(tc, st));
 }
+/* An element exists if the index, counting from the end if negative, is in
+ * range and what is there is not null. */
+MVMint64 MVM_REPR_DEFAULT_EXISTS_POS(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index) {
+    MVMint64 elems = st->REPR->elems(tc, st, root, data);
+    if (index < 0)
+        index += elems;
+    return index >= 0 && index < elems && !MVM_is_null(tc, MVM_repr_at_pos_o(tc, root, index));
+}
 MVM_NO_RETURN static void die_no_ass(MVMThreadContext *tc, const char *repr_name, const char *debug_name) MVM_NO_RETURN_ATTRIBUTE;
 static void die_no_ass(MVMThreadContext *tc, const char *repr_name, const char *debug_name) {
     MVM_exception_throw_adhoc(tc,
@@ -289,6 +297,9 @@ void MVM_repr_initialize_registry(MVMThreadContext *tc) {
     register_core_repr(Capture);
     register_core_repr(Tracked);
     register_core_repr(Stat);
+    register_core_repr(StringBuilder);
+    register_core_repr(ConcHash);
+    register_core_repr(IntHash);
 
     assert(tc->instance->num_reprs == MVM_REPR_CORE_COUNT);
 }
@@ -46,6 +46,9 @@
 #include "6model/reprs/MVMSpeshCandidate.h"
 #include "6model/reprs/MVMTracked.h"
 #include "6model/reprs/MVMStat.h"
+#include "6model/reprs/MVMStringBuilder.h"
+#include "6model/reprs/ConcHash.h"
+#include "6model/reprs/IntHash.h"
 
 /* REPR related functions. */
 void MVM_repr_initialize_registry(MVMThreadContext *tc);
@@ -102,8 +105,11 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
 #define MVM_REPR_ID_MVMCapture              44
 #define MVM_REPR_ID_MVMTracked              45
 #define MVM_REPR_ID_MVMStat                 46
+#define MVM_REPR_ID_MVMStringBuilder        47
+#define MVM_REPR_ID_ConcHash                48
+#define MVM_REPR_ID_IntHash                 49
 
-#define MVM_REPR_CORE_COUNT                 47
+#define MVM_REPR_CORE_COUNT                 50
 #define MVM_REPR_MAX_COUNT                  64
 
 /* Default attribute functions for a REPR that lacks them. */
@@ -150,7 +156,8 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
     MVM_REPR_DEFAULT_POS_AS_ATOMIC, \
     MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM, \
     MVM_REPR_DEFAULT_POS_WRITE_BUF, \
-    MVM_REPR_DEFAULT_POS_READ_BUF \
+    MVM_REPR_DEFAULT_POS_READ_BUF, \
+    MVM_REPR_DEFAULT_EXISTS_POS \
 }
 
 /* Default associative functions for a REPR that lacks them. */
@@ -208,6 +215,7 @@ void MVM_REPR_DEFAULT_DIMENSIONS(MVMThreadContext *tc, MVMSTable *st, MVMObject
 void MVM_REPR_DEFAULT_SET_DIMENSIONS(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_dimensions, MVMint64 *dimensions);
 void MVM_REPR_DEFAULT_POS_WRITE_BUF(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, char *from, MVMint64 offset, MVMuint64 elems);
 MVMint64 MVM_REPR_DEFAULT_POS_READ_BUF(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 offset, MVMuint64 elems);
+MVMint64 MVM_REPR_DEFAULT_EXISTS_POS(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index);
 void MVM_REPR_DEFAULT_AT_POS_MULTIDIM_NO_MULTIDIM(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_indices, MVMint64 *indices, MVMRegister *value, MVMuint16 kind);
 void MVM_REPR_DEFAULT_BIND_POS_MULTIDIM_NO_MULTIDIM(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_indices, MVMint64 *indices, MVMRegister value, MVMuint16 kind);
 void MVM_REPR_DEFAULT_DIMENSIONS_NO_MULTIDIM(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 *num_dimensions, MVMint64 **dimensions);
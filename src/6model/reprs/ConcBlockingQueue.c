@@ -298,7 +298,8 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
         MVM_REPR_DEFAULT_POS_AS_ATOMIC,
         MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM,
         MVM_REPR_DEFAULT_POS_WRITE_BUF,
-        MVM_REPR_DEFAULT_POS_READ_BUF
+        MVM_REPR_DEFAULT_POS_READ_BUF,
+        MVM_REPR_DEFAULT_EXISTS_POS
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
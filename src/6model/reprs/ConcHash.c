@@ -0,0 +1,368 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcHash_this_repr;
+
+/* Base 2 log of the number of slots in the table of a new hash. */
+#define MVM_CONC_HASH_INITIAL_LOG2 3
+
+MVM_STATIC_INLINE MVMString * get_string_key(MVMThreadContext *tc, MVMObject *key) {
+    if (MVM_UNLIKELY(!key || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key)))
+        MVM_exception_throw_adhoc(tc, "ConcHash representation requires MVMString keys");
+    return (MVMString *)key;
+}
+
+/* Tables are kept no more than three quarters full, counting slots that are
+ * claimed by a key but no longer have a value. So probing always ends at an
+ * empty slot. */
+MVM_STATIC_INLINE MVMuint64 max_used(MVMConcHashTable *table) {
+    return ((MVMuint64)3 << table->log2_slots) / 4;
+}
+
+static MVMConcHashTable * allocate_table(MVMuint8 log2_slots) {
+    MVMConcHashTable *table = MVM_calloc(1, sizeof(MVMConcHashTable)
+        + (((size_t)1 << log2_slots) - 1) * sizeof(MVMConcHashSlot));
+    table->log2_slots = log2_slots;
+    return table;
+}
+
+static size_t table_size(MVMConcHashTable *table) {
+    return sizeof(MVMConcHashTable)
+        + (((size_t)1 << table->log2_slots) - 1) * sizeof(MVMConcHashSlot);
+}
+
+static MVMConcHashBody * allocate_body(MVMThreadContext *tc, MVMuint8 log2_slots) {
+    MVMConcHashBody *body = MVM_calloc(1, sizeof(MVMConcHashBody));
+    int init_stat;
+    if ((init_stat = uv_rwlock_init(&body->resize_lock)) < 0) {
+        MVM_free(body);
+        MVM_exception_throw_adhoc(tc, "Failed to initialize read-write lock: %s",
+            uv_strerror(init_stat));
+    }
+    body->table = allocate_table(log2_slots);
+    return body;
+}
+
+/* Finds the slot holding a key, or else the empty slot at which probing for
+ * it ended. Takes no lock, so may be used by readers at any time. */
+static MVMConcHashSlot * find_slot(MVMThreadContext *tc, MVMConcHashTable *table, MVMString *key) {
+    MVMuint64 mask = ((MVMuint64)1 << table->log2_slots) - 1;
+    MVMuint64 i    = MVM_string_hash_code(tc, key) >> (64 - table->log2_slots);
+    while (1) {
+        MVMConcHashSlot *slot  = &(table->slots[i]);
+        MVMString       *found = (MVMString *)MVM_load(&(slot->key));
+        if (!found || found == key || MVM_string_equal(tc, found, key))
+            return slot;
+        i = (i + 1) & mask;
+    }
+}
+
+/* Finds the slot holding a key, claiming an empty one for it if it isn't in
+ * the table yet. Returns NULL if that would take the table over its limit,
+ * in which case it must be grown first. A claim on a slot is reserved in the
+ * count of used slots before the CAS, so that however many threads race to
+ * insert, the table never fills. The caller must hold the resize lock. */
+static MVMConcHashSlot * claim_slot(MVMThreadContext *tc, MVMConcHashTable *table, MVMString *key) {
+    MVMuint64 mask     = ((MVMuint64)1 << table->log2_slots) - 1;
+    MVMuint64 i        = MVM_string_hash_code(tc, key) >> (64 - table->log2_slots);
+    MVMuint32 reserved = 0;
+    while (1) {
+        MVMConcHashSlot *slot  = &(table->slots[i]);
+        MVMString       *found = (MVMString *)MVM_load(&(slot->key));
+        if (!found) {
+            if (!reserved) {
+                if (MVM_incr(&(table->used)) >= max_used(table)) {
+                    MVM_decr(&(table->used));
+                    return NULL;
+                }
+                reserved = 1;
+            }
+            found = (MVMString *)MVM_casptr(&(slot->key), NULL, key);
+            if (!found)
+                return slot;
+            /* Lost the race for this slot; see what key won it. */
+        }
+        if (found == key || MVM_string_equal(tc, found, key)) {
+            if (reserved)
+                MVM_decr(&(table->used));
+            return slot;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/* Swaps the value in a slot, returning the one it replaced. */
+static MVMObject * swap_value(MVMConcHashSlot *slot, MVMObject *value) {
+    MVMObject *old;
+    do {
+        old = (MVMObject *)MVM_load(&(slot->value));
+    } while (MVM_casptr(&(slot->value), old, value) != old);
+    return old;
+}
+
+/* Puts a key and value into a table that nothing else can see yet. */
+static void insert_unshared(MVMThreadContext *tc, MVMConcHashTable *table, MVMString *key, MVMObject *value) {
+    MVMConcHashSlot *slot = find_slot(tc, table, key);
+    slot->key   = key;
+    slot->value = value;
+    table->used++;
+}
+
+/* Replaces a full table with one that has room for at least as many keys
+ * again as have values now. Only the keys with values are copied, so a table
+ * that filled up with deleted keys is cleaned out rather than grown. Readers
+ * may still be probing the old table, so it is freed at the next safepoint.
+ * Nothing else may have replaced the table since it was seen to be full. */
+static void replace_table(MVMThreadContext *tc, MVMConcHashBody *body, MVMConcHashTable *full) {
+    uv_rwlock_wrlock(&(body->resize_lock));
+    if (body->table == full) {
+        MVMuint64 live = MVM_load(&(body->elems));
+        MVMuint8 log2_slots = MVM_CONC_HASH_INITIAL_LOG2;
+        MVMConcHashTable *table;
+        MVMuint64 i;
+        while ((((MVMuint64)3 << log2_slots) / 4) <= 2 * live)
+            log2_slots++;
+        table = allocate_table(log2_slots);
+        for (i = 0; i < (MVMuint64)1 << full->log2_slots; i++) {
+            MVMConcHashSlot *slot = &(full->slots[i]);
+            if (slot->key && slot->value)
+                insert_unshared(tc, table, slot->key, slot->value);
+        }
+        MVM_barrier();
+        MVM_store(&(body->table), table);
+        MVM_free_at_safepoint(tc, full);
+    }
+    uv_rwlock_wrunlock(&(body->resize_lock));
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &ConcHash_this_repr, HOW);
+
+    MVMROOT(tc, st) {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcHash);
+    }
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    *(MVMConcHashBody **)data = allocate_body(tc, MVM_CONC_HASH_INITIAL_LOG2);
+}
+
+/* Copies the body of one object to another. The source may be in use by
+ * other threads, so this is a snapshot of it. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMConcHashBody  *src_body  = *(MVMConcHashBody **)src;
+    MVMConcHashBody  *dest_body = allocate_body(tc, MVM_CONC_HASH_INITIAL_LOG2);
+    MVMConcHashTable *table;
+    MVMuint64 i;
+
+    /* Keep binds and deletes out while copying, sizing the copy to match
+     * whatever table the source has by then. */
+    uv_rwlock_wrlock(&(src_body->resize_lock));
+    table = src_body->table;
+    MVM_free(dest_body->table);
+    dest_body->table = allocate_table(table->log2_slots);
+    for (i = 0; i < (MVMuint64)1 << table->log2_slots; i++) {
+        MVMConcHashSlot *slot = &(table->slots[i]);
+        if (slot->key && slot->value) {
+            insert_unshared(tc, dest_body->table, slot->key, slot->value);
+            dest_body->elems++;
+            MVM_gc_write_barrier(tc, &(dest_root->header), &(slot->key->common.header));
+            MVM_gc_write_barrier(tc, &(dest_root->header), &(slot->value->header));
+        }
+    }
+    uv_rwlock_wrunlock(&(src_body->resize_lock));
+
+    *(MVMConcHashBody **)dest = dest_body;
+}
+
+/* Called by the VM to mark any GCable items. The world is stopped, so there
+ * is no need for locks. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMConcHashBody  *body = *(MVMConcHashBody **)data;
+    MVMConcHashTable *table;
+    MVMuint64 i;
+    if (!body)
+        return;
+    table = body->table;
+    for (i = 0; i < (MVMuint64)1 << table->log2_slots; i++) {
+        MVMConcHashSlot *slot = &(table->slots[i]);
+        if (slot->key) {
+            MVM_gc_worklist_add(tc, worklist, &(slot->key));
+            MVM_gc_worklist_add(tc, worklist, &(slot->value));
+        }
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcHashBody *body = ((MVMConcHash *)obj)->body;
+    if (!body)
+        return;
+    MVM_free(body->table);
+    uv_rwlock_destroy(&(body->resize_lock));
+    MVM_free(body);
+}
+
+static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
+    MVMConcHashBody  *body = *(MVMConcHashBody **)data;
+    MVMString        *key  = get_string_key(tc, key_obj);
+    MVMConcHashTable *table;
+    MVMObject        *value;
+
+    if (MVM_UNLIKELY(kind != MVM_reg_obj))
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+
+    table = (MVMConcHashTable *)MVM_load(&(body->table));
+    value = (MVMObject *)MVM_load(&(find_slot(tc, table, key)->value));
+    result->o = value ? value : tc->instance->VMNull;
+}
+
+/* Binds a value to a key. Neither this nor anything it calls may allocate,
+ * so holding the resize lock never has to wait on GC; that in turn means
+ * that a thread waiting for the lock is not holding up GC for long, so need
+ * not mark itself blocked. */
+static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
+    MVMConcHashBody *body = *(MVMConcHashBody **)data;
+    MVMString       *key  = get_string_key(tc, key_obj);
+    MVMObject       *obj;
+
+    if (MVM_UNLIKELY(kind != MVM_reg_obj))
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+    obj = value.o ? value.o : tc->instance->VMNull;
+
+    MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
+    MVM_gc_write_barrier(tc, &(root->header), &(obj->header));
+    while (1) {
+        MVMConcHashTable *table;
+        MVMConcHashSlot  *slot;
+        uv_rwlock_rdlock(&(body->resize_lock));
+        table = body->table;
+        slot  = claim_slot(tc, table, key);
+        if (slot) {
+            if (!swap_value(slot, obj))
+                MVM_incr(&(body->elems));
+            uv_rwlock_rdunlock(&(body->resize_lock));
+            return;
+        }
+        uv_rwlock_rdunlock(&(body->resize_lock));
+        replace_table(tc, body, table);
+    }
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcHashBody *body = *(MVMConcHashBody **)data;
+    return MVM_load(&(body->elems));
+}
+
+static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMString        *key   = get_string_key(tc, key_obj);
+    MVMConcHashTable *table = (MVMConcHashTable *)MVM_load(&(body->table));
+    return MVM_load(&(find_slot(tc, table, key)->value)) != 0;
+}
+
+/* Deletes a key by clearing its value; the key keeps its slot until the
+ * table is next replaced. */
+static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody *body = *(MVMConcHashBody **)data;
+    MVMString       *key  = get_string_key(tc, key_obj);
+    MVMConcHashSlot *slot;
+
+    uv_rwlock_rdlock(&(body->resize_lock));
+    slot = find_slot(tc, body->table, key);
+    if (slot->key && swap_value(slot, NULL))
+        MVM_decr(&(body->elems));
+    uv_rwlock_rdunlock(&(body->resize_lock));
+}
+
+static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+    spec.can_box         = 0;
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+    return spec;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcHash);
+}
+
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcHashBody *body = *(MVMConcHashBody **)data;
+    return body
+        ? sizeof(MVMConcHashBody) + table_size((MVMConcHashTable *)MVM_load(&(body->table)))
+        : 0;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc) {
+    return &ConcHash_this_repr;
+}
+
+static const MVMREPROps ConcHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    {
+        at_key,
+        bind_key,
+        exists_key,
+        delete_key,
+        get_value_storage_spec
+    },    /* ass_funcs */
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcHash", /* name */
+    MVM_REPR_ID_ConcHash,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
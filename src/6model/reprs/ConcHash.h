@@ -0,0 +1,46 @@
+/* A slot in a concurrent hash table. A key is claimed for a slot by a CAS
+ * from NULL and never changes after that; the value is NULL until bound and
+ * again after the key is deleted. */
+struct MVMConcHashSlot {
+    MVMString *key;
+    MVMObject *value;
+};
+
+/* A table of slots, probed linearly. Tables never shrink or grow in place:
+ * when one fills up, its live entries are copied into a new table, which
+ * replaces it, and it is freed at the next safepoint in case a reader is
+ * still looking at it. */
+struct MVMConcHashTable {
+    /* Number of slots claimed by a key, whether bound or not. */
+    AO_t used;
+
+    /* Base 2 log of the number of slots. */
+    MVMuint8 log2_slots;
+
+    MVMConcHashSlot slots[1];
+};
+
+/* Representation for a hash that may be used from many threads at once.
+ * Lookups take no lock. Binds and deletes CAS keys and values into slots of
+ * the current table, holding a read-write lock for reading only so as to
+ * exclude a concurrent resize, which holds it for writing. Like the body of
+ * a ConcBlockingQueue, this is allocated by malloc() so the GC won't move
+ * the lock. */
+struct MVMConcHashBody {
+    /* The current table. */
+    MVMConcHashTable *table;
+
+    /* Number of keys with a value bound. */
+    AO_t elems;
+
+    uv_rwlock_t resize_lock;
+};
+
+struct MVMConcHash {
+    MVMObject common;
+    /* As noted, a pointer, not an inline struct */
+    MVMConcHashBody *body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc);
@@ -0,0 +1,559 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps IntHash_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &IntHash_this_repr, HOW);
+
+    MVMROOT(tc, st) {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)MVM_malloc(sizeof(MVMIntHashREPRData));
+
+        repr_data->slot_type  = MVM_INTHASH_OBJ;
+        repr_data->value_type = NULL;
+
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMIntHash);
+        st->REPR_data = repr_data;
+    }
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *src_body  = (MVMIntHashBody *)src;
+    MVMIntHashBody     *dest_body = (MVMIntHashBody *)dest;
+
+    MVMIntHashTable *dest_hashtable = &(dest_body->hashtable);
+
+    if (dest_hashtable->table) {
+        /* As for MVMHash, copy_to is only used by clone, which always targets
+         * a freshly created object. */
+        MVM_oops(tc, "copy_to on IntHash that is already initialized");
+    }
+    MVM_int_hash_shallow_copy(tc, &(src_body->hashtable), dest_hashtable);
+    if (repr_data->slot_type == MVM_INTHASH_OBJ || repr_data->slot_type == MVM_INTHASH_STR) {
+        MVMIntHashIterator iterator = MVM_int_hash_first(tc, dest_hashtable);
+        while (!MVM_int_hash_at_end(tc, dest_hashtable, iterator)) {
+            struct MVMIntHashEntry *entry = MVM_int_hash_current(tc, dest_hashtable, iterator);
+            if (entry->value.o)
+                MVM_gc_write_barrier(tc, &(dest_root->header), &(entry->value.o->header));
+            iterator = MVM_int_hash_next(tc, dest_hashtable, iterator);
+        }
+    }
+}
+
+/* Adds held objects to the GC worklist. */
+static void IntHash_gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMIntHashTable    *hashtable = &(body->hashtable);
+    MVMuint64           elems     = MVM_int_hash_count(tc, hashtable);
+
+    /* Aren't holding anything, nothing to do. */
+    if (elems == 0)
+        return;
+    if (repr_data->slot_type != MVM_INTHASH_OBJ && repr_data->slot_type != MVM_INTHASH_STR)
+        return;
+
+    MVM_gc_worklist_presize_for(tc, worklist, elems);
+    if (worklist->include_gen2) {
+        MVMIntHashIterator iterator = MVM_int_hash_first(tc, hashtable);
+        while (!MVM_int_hash_at_end(tc, hashtable, iterator)) {
+            struct MVMIntHashEntry *current = MVM_int_hash_current(tc, hashtable, iterator);
+            MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->value.o);
+            iterator = MVM_int_hash_next(tc, hashtable, iterator);
+        }
+    }
+    else {
+        MVMIntHashIterator iterator = MVM_int_hash_first(tc, hashtable);
+        while (!MVM_int_hash_at_end(tc, hashtable, iterator)) {
+            struct MVMIntHashEntry *current = MVM_int_hash_current(tc, hashtable, iterator);
+            MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &current->value.o);
+            iterator = MVM_int_hash_next(tc, hashtable, iterator);
+        }
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMIntHash *h = (MVMIntHash *)obj;
+    MVM_int_hash_demolish(tc, &(h->body.hashtable));
+}
+
+/* Marks the representation data in an STable.*/
+static void gc_mark_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMGCWorklist *worklist) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    if (repr_data == NULL)
+        return;
+    MVM_gc_worklist_add(tc, worklist, &repr_data->value_type);
+}
+
+/* Frees the representation data in an STable.*/
+static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
+    MVM_free(st->REPR_data);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Checks that the register kind used to access a value matches what we
+ * store. As for VMArray, unsigned and signed registers are interchangeable. */
+static void check_kind(MVMThreadContext *tc, MVMIntHashREPRData *repr_data, MVMuint16 kind, const char *op) {
+    switch (repr_data->slot_type) {
+        case MVM_INTHASH_OBJ:
+            if (kind != MVM_reg_obj)
+                MVM_exception_throw_adhoc(tc, "IntHash: %s expected object register", op);
+            break;
+        case MVM_INTHASH_STR:
+            if (kind != MVM_reg_str)
+                MVM_exception_throw_adhoc(tc, "IntHash: %s expected string register", op);
+            break;
+        case MVM_INTHASH_I64:
+        case MVM_INTHASH_U64:
+            if (kind != MVM_reg_int64 && kind != MVM_reg_uint64)
+                MVM_exception_throw_adhoc(tc, "IntHash: %s expected int register", op);
+            break;
+        case MVM_INTHASH_N64:
+            if (kind != MVM_reg_num64)
+                MVM_exception_throw_adhoc(tc, "IntHash: %s expected num register", op);
+            break;
+        default:
+            MVM_exception_throw_adhoc(tc, "IntHash: Unhandled slot type");
+    }
+}
+
+/* Looks up the value for a key. A missing key gives VMNull for objects, a
+ * null string, or zero. */
+static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 key, MVMRegister *value, MVMuint16 kind) {
+    MVMIntHashREPRData     *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody         *body      = (MVMIntHashBody *)data;
+    struct MVMIntHashEntry *entry;
+
+    check_kind(tc, repr_data, kind, "atpos");
+    entry = MVM_int_hash_fetch(tc, &(body->hashtable), key);
+    if (repr_data->slot_type == MVM_INTHASH_OBJ) {
+        MVMObject *found = entry ? entry->value.o : NULL;
+        value->o = found ? found : tc->instance->VMNull;
+    }
+    else if (entry) {
+        *value = entry->value;
+    }
+    else {
+        value->i64 = 0;
+    }
+}
+
+/* The index is a key, not an offset to check against elems. */
+static MVMint64 exists_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 key) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return MVM_int_hash_fetch(tc, &(body->hashtable), key) != NULL;
+}
+
+static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 key, MVMRegister value, MVMuint16 kind) {
+    MVMIntHashREPRData     *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody         *body      = (MVMIntHashBody *)data;
+    struct MVMIntHashEntry *entry;
+    int                     created;
+
+    check_kind(tc, repr_data, kind, "bindpos");
+    entry = MVM_int_hash_lvalue_fetch(tc, &(body->hashtable), key, &created);
+    switch (repr_data->slot_type) {
+        case MVM_INTHASH_OBJ:
+            MVM_ASSIGN_REF(tc, &(root->header), entry->value.o, value.o);
+            break;
+        case MVM_INTHASH_STR:
+            MVM_ASSIGN_REF(tc, &(root->header), entry->value.s, value.s);
+            break;
+        default:
+            entry->value = value;
+            break;
+    }
+}
+
+static MVMStorageSpec get_elem_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMStorageSpec spec;
+
+    /* initialise storage spec to default values */
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+
+    switch (repr_data->slot_type) {
+        case MVM_INTHASH_STR:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_STR;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_STR;
+            break;
+        case MVM_INTHASH_I64:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_INT;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_INT;
+            break;
+        case MVM_INTHASH_U64:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_UINT64;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_INT;
+            spec.is_unsigned     = 1;
+            break;
+        case MVM_INTHASH_N64:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NUM;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_NUM;
+            break;
+        default:
+            spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+            spec.can_box         = 0;
+            break;
+    }
+    return spec;
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return MVM_int_hash_count(tc, &(body->hashtable));
+}
+
+/* Works out the slot type from the storage spec of the value type. Only the
+ * 64 bit native types are supported; a key lookup costs far more than the
+ * memory narrower values would save. */
+static void spec_to_repr_data(MVMThreadContext *tc, MVMIntHashREPRData *repr_data, const MVMStorageSpec *spec) {
+    switch (spec->boxed_primitive) {
+        case MVM_STORAGE_SPEC_BP_UINT64:
+        case MVM_STORAGE_SPEC_BP_INT:
+            if (spec->bits != 64)
+                MVM_exception_throw_adhoc(tc, "IntHash: Unsupported int size (%d bits); only 64 bit values may be stored", spec->bits);
+            repr_data->slot_type = spec->is_unsigned ? MVM_INTHASH_U64 : MVM_INTHASH_I64;
+            break;
+        case MVM_STORAGE_SPEC_BP_NUM:
+            if (spec->bits != 64)
+                MVM_exception_throw_adhoc(tc, "IntHash: Unsupported num size (%d bits); only 64 bit values may be stored", spec->bits);
+            repr_data->slot_type = MVM_INTHASH_N64;
+            break;
+        case MVM_STORAGE_SPEC_BP_STR:
+            repr_data->slot_type = MVM_INTHASH_STR;
+            break;
+        default:
+            repr_data->slot_type = MVM_INTHASH_OBJ;
+            break;
+    }
+}
+
+/* Compose the representation. The value type comes from the "type" key of
+ * the "inthash" entry of the protocol hash. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
+    MVMStringConsts            str_consts = tc->instance->str_consts;
+    MVMIntHashREPRData * const repr_data  = (MVMIntHashREPRData *)st->REPR_data;
+
+    MVMObject *info = MVM_repr_at_key_o(tc, info_hash, str_consts.inthash);
+    if (!MVM_is_null(tc, info)) {
+        MVMObject *type = MVM_repr_at_key_o(tc, info, str_consts.type);
+        if (!MVM_is_null(tc, type)) {
+            const MVMStorageSpec *spec = REPR(type)->get_storage_spec(tc, STABLE(type));
+            spec_to_repr_data(tc, repr_data, spec);
+            MVM_ASSIGN_REF(tc, &(st->header), repr_data->value_type, type);
+        }
+    }
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMIntHash);
+}
+
+/* Serializes the REPR data. */
+static void serialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationWriter *writer) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVM_serialization_write_ref(tc, writer, repr_data->value_type);
+}
+
+/* Deserializes representation data. */
+static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)MVM_malloc(sizeof(MVMIntHashREPRData));
+
+    MVMObject *type = MVM_serialization_read_ref(tc, reader);
+    MVM_ASSIGN_REF(tc, &(st->header), repr_data->value_type, type);
+    repr_data->slot_type = MVM_INTHASH_OBJ;
+    st->REPR_data = repr_data;
+
+    if (type) {
+        const MVMStorageSpec *spec;
+        MVM_serialization_force_stable(tc, reader, STABLE(type));
+        spec = REPR(type)->get_storage_spec(tc, STABLE(type));
+        spec_to_repr_data(tc, repr_data, spec);
+    }
+}
+
+/* Deserialize the representation. */
+static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMSerializationReader *reader) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMIntHashTable    *hashtable = &(body->hashtable);
+    MVMint64            elems, i;
+
+    if (hashtable->table) {
+        /* As for MVMHash, repossession memsets the body first, so this should
+         * be unreachable. */
+        MVM_oops(tc, "deserialize on IntHash that is already initialized");
+    }
+    elems = MVM_serialization_read_int(tc, reader);
+    for (i = 0; i < elems; i++) {
+        MVMint64 key = MVM_serialization_read_int(tc, reader);
+        int created;
+        struct MVMIntHashEntry *entry = MVM_int_hash_lvalue_fetch(tc, hashtable, key, &created);
+        switch (repr_data->slot_type) {
+            case MVM_INTHASH_OBJ:
+                MVM_ASSIGN_REF(tc, &(root->header), entry->value.o, MVM_serialization_read_ref(tc, reader));
+                break;
+            case MVM_INTHASH_STR:
+                MVM_ASSIGN_REF(tc, &(root->header), entry->value.s, MVM_serialization_read_str(tc, reader));
+                break;
+            case MVM_INTHASH_I64:
+            case MVM_INTHASH_U64:
+                entry->value.i64 = MVM_serialization_read_int(tc, reader);
+                break;
+            case MVM_INTHASH_N64:
+                entry->value.n64 = MVM_serialization_read_num(tc, reader);
+                break;
+        }
+    }
+}
+
+/* Serialize the representation. Keys are written in order, so that the
+ * output doesn't depend upon the hash salt. */
+static int cmp_keys(const void *k1, const void *k2) {
+    MVMint64 a = *(const MVMint64 *)k1;
+    MVMint64 b = *(const MVMint64 *)k2;
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMIntHashTable    *hashtable = &(body->hashtable);
+    MVMuint64           elems     = MVM_int_hash_count(tc, hashtable);
+    MVMint64           *keys      = MVM_malloc(sizeof(MVMint64) * (elems ? elems : 1));
+    MVMuint64           i         = 0;
+
+    MVM_serialization_write_int(tc, writer, elems);
+    MVMIntHashIterator iterator = MVM_int_hash_first(tc, hashtable);
+    while (!MVM_int_hash_at_end(tc, hashtable, iterator)) {
+        keys[i++] = MVM_int_hash_current(tc, hashtable, iterator)->key;
+        iterator = MVM_int_hash_next(tc, hashtable, iterator);
+    }
+    qsort(keys, elems, sizeof(MVMint64), cmp_keys);
+    for (i = 0; i < elems; i++) {
+        struct MVMIntHashEntry *entry = MVM_int_hash_fetch(tc, hashtable, keys[i]);
+        MVM_serialization_write_int(tc, writer, keys[i]);
+        switch (repr_data->slot_type) {
+            case MVM_INTHASH_OBJ:
+                MVM_serialization_write_ref(tc, writer, entry->value.o);
+                break;
+            case MVM_INTHASH_STR:
+                MVM_serialization_write_str(tc, writer, entry->value.s);
+                break;
+            case MVM_INTHASH_I64:
+            case MVM_INTHASH_U64:
+                MVM_serialization_write_int(tc, writer, entry->value.i64);
+                break;
+            case MVM_INTHASH_N64:
+                MVM_serialization_write_num(tc, writer, entry->value.n64);
+                break;
+        }
+    }
+    MVM_free(keys);
+}
+
+/* Bytecode specialization for this REPR. */
+static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    switch (ins->info->opcode) {
+    case MVM_OP_create: {
+        if (!(st->mode_flags & MVM_FINALIZE_TYPE)) {
+            MVMSpeshOperand target   = ins->operands[0];
+            MVMSpeshOperand type     = ins->operands[1];
+            MVMSpeshFacts *tgt_facts = MVM_spesh_get_facts(tc, g, target);
+
+            ins->info                = MVM_op_get_op(MVM_OP_sp_fastcreate);
+            ins->operands            = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+            ins->operands[0]         = target;
+            ins->operands[1].lit_i16 = sizeof(MVMIntHash);
+            ins->operands[2].lit_i16 = MVM_spesh_add_spesh_slot(tc, g, (MVMCollectable *)st);
+            MVM_spesh_usages_delete_by_reg(tc, g, type, ins);
+
+            tgt_facts->flags |= MVM_SPESH_FACT_KNOWN_TYPE | MVM_SPESH_FACT_CONCRETE;
+            tgt_facts->type = st->WHAT;
+        }
+        break;
+    }
+    }
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return MVM_int_hash_allocated_size(tc, &(body->hashtable));
+}
+
+static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMIntHashTable    *hashtable = &(body->hashtable);
+
+    if (repr_data->slot_type != MVM_INTHASH_OBJ && repr_data->slot_type != MVM_INTHASH_STR)
+        return;
+
+    MVMIntHashIterator iterator = MVM_int_hash_first(tc, hashtable);
+    while (!MVM_int_hash_at_end(tc, hashtable, iterator)) {
+        struct MVMIntHashEntry *entry = MVM_int_hash_current(tc, hashtable, iterator);
+        MVM_profile_heap_add_collectable_rel_idx(tc, ss,
+            (MVMCollectable *)entry->value.o, entry->key);
+        iterator = MVM_int_hash_next(tc, hashtable, iterator);
+    }
+}
+
+/* Used by the syscalls for the operations lacking an op. */
+MVMint64 MVM_IntHash_delete_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key) {
+    MVMIntHashBody *body = &((MVMIntHash *)obj)->body;
+    return MVM_int_hash_delete(tc, &(body->hashtable), key);
+}
+
+/* Returns the keys in a new BOOTIntArray, in no particular order. */
+MVMObject * MVM_IntHash_keys(MVMThreadContext *tc, MVMObject *obj) {
+    MVMObject *result;
+    MVMROOT(tc, obj) {
+        result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIntArray);
+    }
+    MVMIntHashTable *hashtable = &(((MVMIntHash *)obj)->body.hashtable);
+    MVMIntHashIterator iterator = MVM_int_hash_first(tc, hashtable);
+    while (!MVM_int_hash_at_end(tc, hashtable, iterator)) {
+        MVM_repr_push_i(tc, result, MVM_int_hash_current(tc, hashtable, iterator)->key);
+        iterator = MVM_int_hash_next(tc, hashtable, iterator);
+    }
+    return result;
+}
+
+/* devirtualized versions of at_pos and bind_pos, for native values, where
+ * the register is simply copied */
+
+static void inthash_at_pos_native(MVMThreadContext *tc, MVMSTable *st, void *data, MVMint64 key, MVMRegister *value) {
+    MVMIntHashBody         *body  = (MVMIntHashBody *)data;
+    struct MVMIntHashEntry *entry = MVM_int_hash_fetch(tc, &(body->hashtable), key);
+    if (entry)
+        *value = entry->value;
+    else
+        value->i64 = 0;
+}
+
+static void inthash_bind_pos_native(MVMThreadContext *tc, MVMSTable *st, void *data, MVMint64 key, MVMRegister value) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    int             created;
+    MVM_int_hash_lvalue_fetch(tc, &(body->hashtable), key, &created)->value = value;
+}
+
+/* devirtualization dispatch function for the JIT to use. Object and string
+ * values need a write barrier, which needs the root, so only get the single
+ * devirtualization. */
+
+void *MVM_IntHash_find_fast_impl_for_jit(MVMThreadContext *tc, MVMSTable *st, MVMint16 op, MVMuint16 kind) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+
+    switch (op) {
+        case MVM_OP_atpos_i:
+        case MVM_OP_atpos_u:
+            if (kind == MVM_reg_int64 || kind == MVM_reg_uint64) {
+                if (repr_data->slot_type == MVM_INTHASH_I64 || repr_data->slot_type == MVM_INTHASH_U64)
+                    return inthash_at_pos_native;
+            }
+            break;
+        case MVM_OP_atpos_n:
+            if (kind == MVM_reg_num64 && repr_data->slot_type == MVM_INTHASH_N64)
+                return inthash_at_pos_native;
+            break;
+        case MVM_OP_bindpos_i:
+        case MVM_OP_bindpos_u:
+            if (kind == MVM_reg_int64 || kind == MVM_reg_uint64) {
+                if (repr_data->slot_type == MVM_INTHASH_I64 || repr_data->slot_type == MVM_INTHASH_U64)
+                    return inthash_bind_pos_native;
+            }
+            break;
+        case MVM_OP_bindpos_n:
+            if (kind == MVM_reg_num64 && repr_data->slot_type == MVM_INTHASH_N64)
+                return inthash_bind_pos_native;
+            break;
+        default:
+            return NULL;
+    }
+    return NULL;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMIntHash_initialize(MVMThreadContext *tc) {
+    return &IntHash_this_repr;
+}
+
+static const MVMREPROps IntHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object, /* serialization.c relies on this and the next line */
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    {
+        at_pos,
+        bind_pos,
+        MVM_REPR_DEFAULT_SET_ELEMS,
+        MVM_REPR_DEFAULT_PUSH,
+        MVM_REPR_DEFAULT_POP,
+        MVM_REPR_DEFAULT_UNSHIFT,
+        MVM_REPR_DEFAULT_SHIFT,
+        MVM_REPR_DEFAULT_SLICE,
+        MVM_REPR_DEFAULT_SPLICE,
+        MVM_REPR_DEFAULT_AT_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_BIND_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_DIMENSIONS,
+        MVM_REPR_DEFAULT_SET_DIMENSIONS,
+        get_elem_storage_spec,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM,
+        MVM_REPR_DEFAULT_POS_WRITE_BUF,
+        MVM_REPR_DEFAULT_POS_READ_BUF,
+        exists_pos
+    },    /* pos_funcs */
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    serialize,
+    deserialize,
+    serialize_repr_data,
+    deserialize_repr_data,
+    deserialize_stable_size,
+    IntHash_gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    gc_mark_repr_data,
+    gc_free_repr_data,
+    compose,
+    spesh,
+    "IntHash", /* name */
+    MVM_REPR_ID_IntHash,
+    unmanaged_size,
+    describe_refs,
+};
@@ -0,0 +1,35 @@
+/* Representation for a hash keyed on native integers. It is accessed through
+ * the positional ops, with the index being the key, so that lookups need not
+ * box their keys and get the usual spesh and JIT devirtualization. The values
+ * are objects, or one of the native kinds chosen at compose time. */
+struct MVMIntHashBody {
+    MVMIntHashTable hashtable;
+};
+
+struct MVMIntHash {
+    MVMObject common;
+    MVMIntHashBody body;
+};
+
+/* Kinds of value that may be stored. */
+#define MVM_INTHASH_OBJ     0
+#define MVM_INTHASH_STR     1
+#define MVM_INTHASH_I64     2
+#define MVM_INTHASH_U64     3
+#define MVM_INTHASH_N64     4
+
+/* The value type, as set up by compose. */
+struct MVMIntHashREPRData {
+    /* The kind of value we store. */
+    MVMuint8 slot_type;
+
+    /* The type object for the values, if one was given. */
+    MVMObject *value_type;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMIntHash_initialize(MVMThreadContext *tc);
+
+MVMint64 MVM_IntHash_delete_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key);
+MVMObject * MVM_IntHash_keys(MVMThreadContext *tc, MVMObject *obj);
+void *MVM_IntHash_find_fast_impl_for_jit(MVMThreadContext *tc, MVMSTable *st, MVMint16 op, MVMuint16 kind);
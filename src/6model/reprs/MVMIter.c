@@ -192,7 +192,8 @@ static const MVMREPROps MVMIter_this_repr = {
         MVM_REPR_DEFAULT_POS_AS_ATOMIC,
         MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM,
         MVM_REPR_DEFAULT_POS_WRITE_BUF,
-        MVM_REPR_DEFAULT_POS_READ_BUF
+        MVM_REPR_DEFAULT_POS_READ_BUF,
+        MVM_REPR_DEFAULT_EXISTS_POS
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     MVM_REPR_DEFAULT_ELEMS,
@@ -0,0 +1,337 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps StringBuilder_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &StringBuilder_this_repr, HOW);
+
+    MVMROOT(tc, st) {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStringBuilder);
+    }
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMStringBuilderBody *src_body  = (MVMStringBuilderBody *)src;
+    MVMStringBuilderBody *dest_body = (MVMStringBuilderBody *)dest;
+    *dest_body = *src_body;
+    if (src_body->alloc) {
+        size_t size = src_body->alloc * (src_body->is_32bit ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8));
+        dest_body->buffer.any = MVM_malloc(size);
+        memcpy(dest_body->buffer.any, src_body->buffer.any, size);
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVM_free(((MVMStringBuilder *)obj)->body.buffer.any);
+}
+
+/* The number of graphemes built up so far. */
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    return ((MVMStringBuilderBody *)data)->num_graphs;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStringBuilder);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    return body->alloc * (body->is_32bit ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8));
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc) {
+    return &StringBuilder_this_repr;
+}
+
+static const MVMREPROps StringBuilder_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    {
+        MVM_REPR_DEFAULT_SET_INT,
+        MVM_REPR_DEFAULT_GET_INT,
+        MVM_REPR_DEFAULT_SET_NUM,
+        MVM_REPR_DEFAULT_GET_NUM,
+        MVM_REPR_DEFAULT_SET_STR,
+        MVM_REPR_DEFAULT_GET_STR,
+        MVM_REPR_DEFAULT_SET_UINT,
+        MVM_REPR_DEFAULT_GET_UINT,
+        MVM_REPR_DEFAULT_GET_BOXED_REF
+    },    /* box_funcs */
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "MVMStringBuilder", /* name */
+    MVM_REPR_ID_MVMStringBuilder,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+#define can_fit_into_8bit(g) ((-128 <= (g) && (g) <= 127))
+
+/* Makes sure there is space in the buffer for another needed graphemes. */
+static void ensure_space(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMuint64 needed) {
+    MVMuint64 wanted = (MVMuint64)body->num_graphs + needed;
+    if (wanted > body->alloc) {
+        MVMuint64 new_alloc = (MVMuint64)body->alloc * 2;
+        if (wanted > 0xFFFFFFFFULL)
+            MVM_exception_throw_adhoc(tc,
+                "Can't build a string of %"PRIu64" graphemes, which is more than allowed",
+                wanted);
+        if (new_alloc < wanted)
+            new_alloc = wanted;
+        if (new_alloc < 16)
+            new_alloc = 16;
+        if (new_alloc > 0xFFFFFFFFULL)
+            new_alloc = 0xFFFFFFFFULL;
+        body->buffer.any = MVM_realloc(body->buffer.any,
+            new_alloc * (body->is_32bit ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8)));
+        body->alloc = (MVMuint32)new_alloc;
+    }
+}
+
+/* Switches the buffer over to 32-bit graphemes. */
+static void widen(MVMThreadContext *tc, MVMStringBuilderBody *body) {
+    MVMGrapheme32 *wide = MVM_malloc((body->alloc ? body->alloc : 1) * sizeof(MVMGrapheme32));
+    MVMuint32 i;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < body->num_graphs; i++)
+        wide[i] = body->buffer.blob_8[i];
+    MVM_free(body->buffer.blob_8);
+    body->buffer.blob_32 = wide;
+    body->is_32bit = 1;
+}
+
+static void push_grapheme(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMGrapheme32 g) {
+    if (!body->is_32bit && !can_fit_into_8bit(g))
+        widen(tc, body);
+    ensure_space(tc, body, 1);
+    if (body->is_32bit)
+        body->buffer.blob_32[body->num_graphs++] = g;
+    else
+        body->buffer.blob_8[body->num_graphs++] = (MVMGrapheme8)g;
+}
+
+static void append_8(MVMThreadContext *tc, MVMStringBuilderBody *body, const MVMGrapheme8 *graphs, MVMuint32 n) {
+    ensure_space(tc, body, n);
+    if (body->is_32bit) {
+        MVMGrapheme32 *to = body->buffer.blob_32 + body->num_graphs;
+        MVMuint32 i;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < n; i++)
+            to[i] = graphs[i];
+    }
+    else {
+        memcpy(body->buffer.blob_8 + body->num_graphs, graphs, n);
+    }
+    body->num_graphs += n;
+}
+
+static void append_32(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMGrapheme32 *graphs, MVMuint32 n) {
+    if (!body->is_32bit && !MVM_string_buf32_can_fit_into_8bit(graphs, n))
+        widen(tc, body);
+    ensure_space(tc, body, n);
+    if (body->is_32bit) {
+        memcpy(body->buffer.blob_32 + body->num_graphs, graphs, n * sizeof(MVMGrapheme32));
+    }
+    else {
+        MVMGrapheme8 *to = body->buffer.blob_8 + body->num_graphs;
+        MVMuint32 i;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < n; i++)
+            to[i] = (MVMGrapheme8)graphs[i];
+    }
+    body->num_graphs += n;
+}
+
+/* Appends the graphemes of a string, starting at the given index. Flat
+ * strings are copied in bulk; strands are iterated. */
+static void append_graphemes(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMString *s, MVMuint32 from) {
+    MVMuint32 n = MVM_string_graphs_nocheck(tc, s) - from;
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32:
+            append_32(tc, body, s->body.storage.blob_32 + from, n);
+            break;
+        case MVM_STRING_IN_SITU_32:
+            append_32(tc, body, s->body.storage.in_situ_32 + from, n);
+            break;
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            append_8(tc, body, s->body.storage.blob_8 + from, n);
+            break;
+        case MVM_STRING_IN_SITU_8:
+            append_8(tc, body, s->body.storage.in_situ_8 + from, n);
+            break;
+        default: {
+            MVMGraphemeIter gi;
+            MVM_string_gi_init(tc, &gi, s);
+            if (from)
+                MVM_string_gi_move_to(tc, &gi, from);
+            ensure_space(tc, body, n);
+            while (n--)
+                push_grapheme(tc, body, MVM_string_gi_get_grapheme(tc, &gi));
+        }
+    }
+}
+
+MVM_STATIC_INLINE MVMGrapheme32 last_grapheme(MVMStringBuilderBody *body) {
+    return body->is_32bit
+        ? body->buffer.blob_32[body->num_graphs - 1]
+        : body->buffer.blob_8[body->num_graphs - 1];
+}
+
+/* Normalizes the codepoints of two graphemes that may combine when placed
+ * next to each other, as MVM_string_concatenate does at the join. */
+static MVMString * renormalize_join(MVMThreadContext *tc, MVMGrapheme32 last, MVMGrapheme32 first) {
+    MVMCodepointIter last_ci;
+    MVMCodepointIter first_ci;
+    MVMuint32 last_codes  = MVM_string_grapheme_ci_init(tc, &last_ci,  last, 1);
+    MVMuint32 first_codes = MVM_string_grapheme_ci_init(tc, &first_ci, first, 1);
+    MVMCodepoint *codes = alloca((last_codes + first_codes) * sizeof(MVMCodepoint));
+    MVMuint32 i = 0;
+    for (; MVM_string_grapheme_ci_has_more(tc, &last_ci); i++)
+        codes[i] = MVM_string_grapheme_ci_get_codepoint(tc, &last_ci);
+    for (; MVM_string_grapheme_ci_has_more(tc, &first_ci); i++)
+        codes[i] = MVM_string_grapheme_ci_get_codepoint(tc, &first_ci);
+    return MVM_unicode_codepoints_c_array_to_nfg_string(tc, codes, last_codes + first_codes);
+}
+
+/* Appends a string to the builder, keeping the result in NFG. */
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMObject *builder, MVMString *s) {
+    MVMStringBuilderBody *body = &((MVMStringBuilder *)builder)->body;
+    MVMuint32 from = 0;
+    MVM_string_check_arg(tc, s, "string builder append");
+    if (MVM_string_graphs_nocheck(tc, s) == 0)
+        return;
+    if (body->num_graphs) {
+        MVMGrapheme32 last  = last_grapheme(body);
+        MVMGrapheme32 first = MVM_string_get_grapheme_at_nocheck(tc, s, 0);
+        if (!MVM_nfg_is_grapheme_concat_stable(tc, last, first)) {
+            MVMString *join;
+            MVMROOT2(tc, builder, s) {
+                join = renormalize_join(tc, last, first);
+            }
+            body = &((MVMStringBuilder *)builder)->body;
+            body->num_graphs--;
+            append_graphemes(tc, body, join, 0);
+            from = 1;
+        }
+    }
+    append_graphemes(tc, body, s, from);
+}
+
+/* Appends a codepoint to the builder. Codepoints that are their own NFG
+ * grapheme and can't combine with what came before are pushed directly. */
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *builder, MVMint64 cp) {
+    MVMStringBuilderBody *body = &((MVMStringBuilder *)builder)->body;
+    MVMString *s;
+    if (0 <= cp && cp < MVM_NORMALIZE_FIRST_SIG_NFC && (body->num_graphs == 0
+            || MVM_nfg_is_grapheme_concat_stable(tc, last_grapheme(body), (MVMGrapheme32)cp))) {
+        push_grapheme(tc, body, (MVMGrapheme32)cp);
+        return;
+    }
+    MVMROOT(tc, builder) {
+        s = MVM_string_chr(tc, cp);
+    }
+    MVM_string_builder_append_str(tc, builder, s);
+}
+
+/* Appends the decimal representation of an integer to the builder. */
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMObject *builder, MVMint64 value) {
+    MVMStringBuilderBody *body = &((MVMStringBuilder *)builder)->body;
+    char digits[32];
+    int length = snprintf(digits, sizeof(digits), "%"PRId64, value);
+    if (body->num_graphs && !MVM_nfg_is_grapheme_concat_stable(tc, last_grapheme(body), digits[0])) {
+        MVMString *s;
+        MVMROOT(tc, builder) {
+            s = MVM_string_ascii_decode(tc, tc->instance->VMString, digits, length);
+        }
+        MVM_string_builder_append_str(tc, builder, s);
+        return;
+    }
+    append_8(tc, body, (MVMGrapheme8 *)digits, length);
+}
+
+/* Produces a string from what has been built up, handing the buffer over to
+ * it, and leaves the builder empty. */
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMObject *builder) {
+    MVMStringBuilderBody *body;
+    MVMString *result;
+    MVMROOT(tc, builder) {
+        result = (MVMString *)REPR(tc->instance->VMString)->allocate(tc, STABLE(tc->instance->VMString));
+    }
+    body = &((MVMStringBuilder *)builder)->body;
+    result->body.num_graphs = body->num_graphs;
+    if (!body->is_32bit && body->num_graphs <= 8) {
+        result->body.storage_type = MVM_STRING_IN_SITU_8;
+        if (body->num_graphs)
+            memcpy(result->body.storage.in_situ_8, body->buffer.blob_8, body->num_graphs);
+        MVM_free(body->buffer.any);
+    }
+    else {
+        /* Give back space we overallocated if it's worth it. */
+        if (body->alloc - body->num_graphs > 8)
+            body->buffer.any = MVM_realloc(body->buffer.any, body->num_graphs
+                * (body->is_32bit ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8)));
+        if (body->is_32bit) {
+            result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+            result->body.storage.blob_32 = body->buffer.blob_32;
+        }
+        else {
+            result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+            result->body.storage.blob_8  = body->buffer.blob_8;
+        }
+    }
+    body->buffer.any = NULL;
+    body->num_graphs = 0;
+    body->alloc      = 0;
+    body->is_32bit   = 0;
+    return result;
+}
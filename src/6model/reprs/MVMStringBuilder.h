@@ -0,0 +1,31 @@
+/* A growable buffer of graphemes, for building up a string from many pieces
+ * without allocating an intermediate string for each of them. Graphemes are
+ * kept 8 bits wide until one that doesn't fit turns up, and the buffer is
+ * handed over to the string produced at the end rather than copied. */
+struct MVMStringBuilderBody {
+    union {
+        MVMGrapheme8  *blob_8;
+        MVMGrapheme32 *blob_32;
+        void          *any;
+    } buffer;
+
+    /* Number of graphemes in the buffer, and how many it has space for. */
+    MVMuint32 num_graphs;
+    MVMuint32 alloc;
+
+    /* Whether the buffer holds 32-bit graphemes. */
+    MVMuint8 is_32bit;
+};
+struct MVMStringBuilder {
+    MVMObject common;
+    MVMStringBuilderBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc);
+
+/* Operations on a string builder. */
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMObject *builder, MVMString *s);
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *builder, MVMint64 cp);
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMObject *builder, MVMint64 value);
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMObject *builder);
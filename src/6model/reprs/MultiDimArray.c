@@ -840,6 +840,7 @@ static const MVMREPROps MultiDimArray_this_repr = {
         pos_as_atomic_multidim,
         MVM_REPR_DEFAULT_POS_WRITE_BUF,
         MVM_REPR_DEFAULT_POS_READ_BUF,
+        MVM_REPR_DEFAULT_EXISTS_POS
     },
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
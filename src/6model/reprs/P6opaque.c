@@ -1519,6 +1519,16 @@ static void osplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     REPR(del)->pos_funcs.splice(tc, STABLE(del), del, OBJECT_BODY(del), target_array, offset, elems);
 }
 
+static MVMint64 exists_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index) {
+    MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
+    MVMObject *del;
+    if (repr_data->pos_del_slot == -1)
+        die_no_pos_del(tc, st);
+    data = MVM_p6opaque_real_data(tc, data);
+    del = get_obj_at_offset(data, repr_data->attribute_offsets[repr_data->pos_del_slot]);
+    return REPR(del)->pos_funcs.exists_pos(tc, STABLE(del), del, OBJECT_BODY(del), index);
+}
+
 static void die_no_ass_del(MVMThreadContext *tc, MVMSTable *st) {
     MVM_exception_throw_adhoc(tc, "This type (%s) does not support associative operations", MVM_6model_get_stable_debug_name(tc, st));
 }
@@ -2291,6 +2301,7 @@ static const MVMREPROps P6opaque_this_repr = {
         MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM,
         MVM_REPR_DEFAULT_POS_WRITE_BUF,
         MVM_REPR_DEFAULT_POS_READ_BUF,
+        exists_pos
     },    /* pos_funcs */
     {
         at_key,
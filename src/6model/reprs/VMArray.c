@@ -1575,7 +1575,8 @@ static const MVMREPROps VMArray_this_repr = {
         pos_as_atomic,
         pos_as_atomic_multidim,
         write_buf,
-        read_buf
+        read_buf,
+        MVM_REPR_DEFAULT_EXISTS_POS
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
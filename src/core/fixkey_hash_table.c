@@ -26,6 +26,14 @@ void MVM_fixkey_hash_demolish(MVMThreadContext *tc, MVMFixKeyHashTable *hashtabl
             if (*metadata) {
                 MVMString ***indirection = (MVMString ***) entry_raw;
                 MVM_free(*indirection);
+            } else {
+                MVMuint32 empty = MVM_hash_empty_run(metadata, entries_in_use - bucket);
+                if (empty) {
+                    bucket += empty;
+                    metadata += empty;
+                    entry_raw -= empty * sizeof(MVMString ***);
+                    continue;
+                }
             }
             ++bucket;
             ++metadata;
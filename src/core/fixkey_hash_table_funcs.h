@@ -172,6 +172,14 @@ MVM_STATIC_INLINE void MVM_fixkey_hash_foreach(MVMThreadContext *tc, MVMFixKeyHa
             MVMString ***indirection = (MVMString ***) entry_raw;
             assert(indirection);
             callback(tc, *indirection, arg);
+        } else {
+            MVMuint32 empty = MVM_hash_empty_run(metadata, entries_in_use - bucket);
+            if (empty) {
+                bucket += empty;
+                metadata += empty;
+                entry_raw -= empty * sizeof(MVMString ***);
+                continue;
+            }
         }
         ++bucket;
         ++metadata;
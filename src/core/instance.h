@@ -25,6 +25,7 @@ struct MVMBootTypes {
     MVMObject *BOOTCapture;
     MVMObject *BOOTTracked;
     MVMObject *BOOTStat;
+    MVMObject *BOOTStringBuilder;
 };
 
 /* Various raw types that don't need a HOW */
@@ -59,6 +60,7 @@ struct MVMStringConsts {
     MVMString *anon;
     MVMString *P6opaque;
     MVMString *array;
+    MVMString *inthash;
     MVMString *box_target;
     MVMString *positional_delegate;
     MVMString *associative_delegate;
@@ -278,6 +280,12 @@ struct MVMInstance {
     /* Registry of dispatchers. */
     MVMDispRegistry disp_registry;
 
+    /* Dispatch programs shared between megamorphic call sites. */
+    MVMDispMegamorphicCache disp_megamorphic;
+
+    /* Per call site dispatch statistics, if MVM_DISP_STATS_LOG is set. */
+    MVMDispStats *disp_stats;
+
     /* MoarVM system calls hash (VM-provided functionality). */
     MVMFixKeyHashTable syscalls;
 
@@ -350,6 +358,16 @@ struct MVMInstance {
     /* File for JIT perf map logging */
     FILE *jit_perf_map;
 
+    /* File for the perf jitdump format, which unlike the perf map also
+     * carries the code bytes; the marker is the executable mapping of it
+     * perf uses to find the file, and the index numbers the records. */
+    FILE *jit_perf_dump;
+    void *jit_perf_dump_marker;
+    AO_t  jit_perf_dump_index;
+
+    /* Pooled executable memory for JIT output. */
+    MVMJitCodeHeap *jit_code_heap;
+
     /* Directory name for JIT bytecode dumps */
     char *jit_bytecode_dir;
 
@@ -441,6 +459,10 @@ struct MVMInstance {
 
     uv_mutex_t       mutex_property_codes_hash_setup;
 
+    /* Bitmap of codepoints that are stable under NFC and NFG, as blocks that
+     * are filled in on first use (see MVM_unicode_normalizer_is_stable). */
+    MVMuint32      **normalize_stable_blocks;
+
     /************************************************************************
      * Type objects for built-in types and special values
      ************************************************************************/
@@ -0,0 +1,339 @@
+#include "moar.h"
+
+#define INT_INITIAL_SIZE_LOG2 3
+
+MVM_STATIC_INLINE void hash_demolish_internal(MVMThreadContext *tc,
+                                              struct MVMIntHashTableControl *control) {
+    size_t allocated_items = MVM_int_hash_allocated_items(control);
+    size_t entries_size = sizeof(struct MVMIntHashEntry) * allocated_items;
+    char *start = (char *)control - entries_size;
+    MVM_free_at_safepoint(tc, start);
+}
+
+/* Frees the entire contents of the hash, leaving you just the hashtable itself,
+   which you allocated (heap, stack, inside another struct, wherever) */
+void MVM_int_hash_demolish(MVMThreadContext *tc, MVMIntHashTable *hashtable) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    if (!control)
+        return;
+    hash_demolish_internal(tc, control);
+    hashtable->table = NULL;
+}
+/* and then free memory if you allocated it */
+
+
+MVM_STATIC_INLINE struct MVMIntHashTableControl *hash_allocate_common(MVMThreadContext *tc,
+                                                                      MVMuint8 official_size_log2) {
+    MVMuint32 official_size = 1 << (MVMuint32)official_size_log2;
+    MVMuint32 max_items = official_size * MVM_INT_HASH_LOAD_FACTOR;
+    MVMuint8 max_probe_distance_limit;
+    if (MVM_HASH_MAX_PROBE_DISTANCE < max_items) {
+        max_probe_distance_limit = MVM_HASH_MAX_PROBE_DISTANCE;
+    } else {
+        max_probe_distance_limit = max_items;
+    }
+    size_t allocated_items = official_size + max_probe_distance_limit - 1;
+    size_t entries_size = sizeof(struct MVMIntHashEntry) * allocated_items;
+    size_t metadata_size = MVM_hash_round_size_up(allocated_items + 1);
+    size_t total_size
+        = entries_size + sizeof(struct MVMIntHashTableControl) + metadata_size;
+    assert(total_size == MVM_hash_round_size_up(total_size));
+
+    struct MVMIntHashTableControl *control =
+        (struct MVMIntHashTableControl *) ((char *)MVM_malloc(total_size) + entries_size);
+
+    control->official_size_log2 = official_size_log2;
+    control->max_items = max_items;
+    control->cur_items = 0;
+    control->metadata_hash_bits = MVM_HASH_INITIAL_BITS_IN_METADATA;
+    /* As MVM_HASH_INITIAL_BITS_IN_METADATA is 5, this evaluates to 7: */
+    MVMuint8 initial_probe_distance = (1 << (8 - MVM_HASH_INITIAL_BITS_IN_METADATA)) - 1;
+    control->max_probe_distance = max_probe_distance_limit > initial_probe_distance ? initial_probe_distance : max_probe_distance_limit;
+    control->max_probe_distance_limit = max_probe_distance_limit;
+    MVMuint8 bucket_right_shift = 8 * sizeof(MVMuint64) - official_size_log2;
+    control->key_right_shift = bucket_right_shift - control->metadata_hash_bits;
+#if MVM_HASH_RANDOMIZE
+    control->salt = MVM_proc_rand_i(tc);
+#else
+    control->salt = 0;
+#endif
+
+    MVMuint8 *metadata = (MVMuint8 *)(control + 1);
+    memset(metadata, 0, metadata_size);
+
+    return control;
+}
+
+void MVM_int_hash_shallow_copy(MVMThreadContext *tc,
+                               MVMIntHashTable *source,
+                               MVMIntHashTable *dest) {
+    const struct MVMIntHashTableControl *control = source->table;
+    if (!control) {
+        dest->table = NULL;
+        return;
+    }
+    size_t allocated_items = MVM_int_hash_allocated_items(control);
+    size_t entries_size = sizeof(struct MVMIntHashEntry) * allocated_items;
+    size_t metadata_size = MVM_hash_round_size_up(allocated_items + 1);
+    const char *start = (const char *)control - entries_size;
+    size_t total_size
+        = entries_size + sizeof(struct MVMIntHashTableControl) + metadata_size;
+    char *target = (char *) MVM_malloc(total_size);
+    memcpy(target, start, total_size);
+    dest->table = (struct MVMIntHashTableControl *)(target + entries_size);
+}
+
+MVM_STATIC_INLINE struct MVMIntHashEntry *hash_insert_internal(MVMThreadContext *tc,
+                                                               struct MVMIntHashTableControl *control,
+                                                               MVMint64 key,
+                                                               int *created) {
+    if (MVM_UNLIKELY(control->cur_items >= control->max_items)) {
+        MVM_oops(tc, "oops, attempt to recursively call grow when adding %"PRIi64,
+                 key);
+    }
+
+    struct MVM_hash_loop_state ls = MVM_int_hash_create_loop_state(control, key);
+
+    while (1) {
+        if (*ls.metadata < ls.probe_distance) {
+            /* this is our slot. occupied or not, it is our rightful place. */
+
+            if (*ls.metadata == 0) {
+                /* Open goal. Score! */
+            } else {
+                /* make room. See the comments in the MVMPtrHashTable
+                 * implementation of this. */
+                MVMuint8 *find_me_a_gap = ls.metadata;
+                MVMuint8 old_probe_distance = *ls.metadata;
+                do {
+                    MVMuint32 new_probe_distance = ls.metadata_increment + old_probe_distance;
+                    if (new_probe_distance >> ls.probe_distance_shift == ls.max_probe_distance) {
+                        /* Force a resize on the next insert. */
+                        control->max_items = 0;
+                    }
+                    /* a swap: */
+                    old_probe_distance = *++find_me_a_gap;
+                    *find_me_a_gap = new_probe_distance;
+                } while (old_probe_distance);
+
+                MVMuint32 entries_to_move = find_me_a_gap - ls.metadata;
+                size_t size_to_move = (size_t) ls.entry_size * entries_to_move;
+                /* Entries are descending in memory, so move everything at
+                 * `entry_raw` and *before* it downwards. */
+                MVMuint8 *dest = ls.entry_raw - size_to_move;
+                memmove(dest, dest + ls.entry_size, size_to_move);
+            }
+
+            /* As in the "make room" loop - we're about to insert something at
+             * the (current) max_probe_distance, so signal to the next
+             * insertion that it needs to take action first. */
+            if (ls.probe_distance >> ls.probe_distance_shift == control->max_probe_distance) {
+                control->max_items = 0;
+            }
+
+            ++control->cur_items;
+
+            *ls.metadata = ls.probe_distance;
+            struct MVMIntHashEntry *entry = (struct MVMIntHashEntry *) ls.entry_raw;
+            entry->key = key;
+            entry->value.i64 = 0;
+            *created = 1;
+            return entry;
+        }
+        else if (*ls.metadata == ls.probe_distance) {
+            struct MVMIntHashEntry *entry = (struct MVMIntHashEntry *) ls.entry_raw;
+            if (entry->key == key) {
+                *created = 0;
+                return entry;
+            }
+        }
+        ls.probe_distance += ls.metadata_increment;
+        ++ls.metadata;
+        ls.entry_raw -= ls.entry_size;
+
+        /* For insert, the loop must not iterate to any probe distance greater
+         * than the (current) maximum probe distance. */
+        assert(ls.probe_distance < (ls.max_probe_distance + 1) * ls.metadata_increment);
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + MVM_int_hash_max_items(control));
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + 256);
+    }
+}
+
+static struct MVMIntHashTableControl *maybe_grow_hash(MVMThreadContext *tc,
+                                                      struct MVMIntHashTableControl *control) {
+    /* control->max_items may have been set to 0 to trigger a call into this
+     * function. */
+    MVMuint32 max_items = MVM_int_hash_max_items(control);
+    MVMuint32 max_probe_distance = control->max_probe_distance;
+    MVMuint32 max_probe_distance_limit = control->max_probe_distance_limit;
+
+    /* We can hit both the probe limit and the max items on the same insertion.
+     * In which case, upping the probe limit isn't going to save us :-)
+     * But if we hit the probe limit max (even without hitting the max items)
+     * then we don't have more space in the metadata, so we're going to have to
+     * grow anyway. */
+    if (control->cur_items < max_items
+        && max_probe_distance < max_probe_distance_limit) {
+        /* We hit the probe limit, but not the max items count. */
+        MVMuint32 new_probe_distance = 1 + 2 * max_probe_distance;
+        if (new_probe_distance > max_probe_distance_limit) {
+            new_probe_distance = max_probe_distance_limit;
+        }
+
+        MVMuint8 *metadata = MVM_int_hash_metadata(control);
+        MVMuint32 in_use_items = MVM_int_hash_official_size(control) + max_probe_distance;
+        /* not `in_use_items + 1` because because we don't need to shift the
+         * sentinel. */
+        size_t metadata_size = MVM_hash_round_size_up(in_use_items);
+        size_t loop_count = metadata_size / sizeof(unsigned long);
+        unsigned long *p = (unsigned long *) metadata;
+        /* right shift each byte by 1 bit, clearing the top bit. */
+        do {
+            *p = (*p >> 1) & (0x7F7F7F7FUL | (0x7F7F7F7FUL << (4 * sizeof(long))));
+            ++p;
+        } while (--loop_count);
+        assert(control->metadata_hash_bits);
+        --control->metadata_hash_bits;
+        ++control->key_right_shift;
+
+        control->max_probe_distance = new_probe_distance;
+        /* Reset this to its proper value. */
+        control->max_items = max_items;
+        assert(control->max_items);
+        return NULL;
+    }
+
+    MVMuint32 entries_in_use = MVM_int_hash_official_size(control) + control->max_probe_distance - 1;
+    MVMuint8 *entry_raw_orig = MVM_int_hash_entries(control);
+    MVMuint8 *metadata_orig = MVM_int_hash_metadata(control);
+
+    struct MVMIntHashTableControl *control_orig = control;
+
+    control = hash_allocate_common(tc, control_orig->official_size_log2 + 1);
+
+    MVMuint8 *entry_raw = entry_raw_orig;
+    MVMuint8 *metadata = metadata_orig;
+    MVMHashNumItems bucket = 0;
+    while (bucket < entries_in_use) {
+        if (*metadata) {
+            struct MVMIntHashEntry *old_entry = (struct MVMIntHashEntry *) entry_raw;
+            int created;
+            struct MVMIntHashEntry *new_entry =
+                hash_insert_internal(tc, control, old_entry->key, &created);
+            assert(created);
+            *new_entry = *old_entry;
+
+            if (!control->max_items) {
+                /* Probably we hit the probe limit.
+                 * But it's just possible that one actual "grow" wasn't enough.
+                 */
+                struct MVMIntHashTableControl *new_control
+                    = maybe_grow_hash(tc, control);
+                if (new_control) {
+                    control = new_control;
+                }
+            }
+        }
+        ++bucket;
+        ++metadata;
+        entry_raw -= sizeof(struct MVMIntHashEntry);
+    }
+    hash_demolish_internal(tc, control_orig);
+    return control;
+}
+
+struct MVMIntHashEntry *MVM_int_hash_lvalue_fetch(MVMThreadContext *tc,
+                                                  MVMIntHashTable *hashtable,
+                                                  MVMint64 key,
+                                                  int *created) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    if (MVM_UNLIKELY(!control)) {
+        control = hash_allocate_common(tc, INT_INITIAL_SIZE_LOG2);
+        hashtable->table = control;
+    }
+    else if (MVM_UNLIKELY(control->cur_items >= control->max_items)) {
+        /* We should avoid growing the hash if we don't need to.
+         * It's expensive, and for hashes with iterators, growing the hash
+         * invalidates iterators. Which is buggy behaviour if the fetch doesn't
+         * need to create a key. */
+        struct MVMIntHashEntry *entry = MVM_int_hash_fetch(tc, hashtable, key);
+        if (entry) {
+            *created = 0;
+            return entry;
+        }
+
+        struct MVMIntHashTableControl *new_control = maybe_grow_hash(tc, control);
+        if (new_control) {
+            hashtable->table = control = new_control;
+        }
+    }
+    return hash_insert_internal(tc, control, key, created);
+}
+
+int MVM_int_hash_delete(MVMThreadContext *tc,
+                        MVMIntHashTable *hashtable,
+                        MVMint64 key) {
+    if (MVM_int_hash_is_empty(tc, hashtable)) {
+        return 0;
+    }
+
+    struct MVMIntHashTableControl *control = hashtable->table;
+    struct MVM_hash_loop_state ls = MVM_int_hash_create_loop_state(control, key);
+
+    while (1) {
+        if (*ls.metadata == ls.probe_distance) {
+            struct MVMIntHashEntry *entry = (struct MVMIntHashEntry *) ls.entry_raw;
+            if (entry->key == key) {
+                /* Target acquired. */
+                uint8_t *metadata_target = ls.metadata;
+                /* Look at the next slot */
+                uint8_t old_probe_distance = metadata_target[1];
+                const uint8_t can_move = 2 * ls.metadata_increment;
+                while (old_probe_distance >= can_move) {
+                    /* OK, we can move this one. */
+                    *metadata_target = old_probe_distance - ls.metadata_increment;
+                    /* Try the next one, etc */
+                    ++metadata_target;
+                    old_probe_distance = metadata_target[1];
+                }
+                /* metadata_target now points to the metadata for the last thing
+                   we did move. (possibly still our target). */
+
+                uint32_t entries_to_move = metadata_target - ls.metadata;
+                if (entries_to_move) {
+                    size_t size_to_move = (size_t) ls.entry_size * entries_to_move;
+                    /* Move everything *before* the entry that we need to
+                     * overwrite upwards to close the gap. */
+                    memmove(ls.entry_raw - size_to_move + ls.entry_size,
+                            ls.entry_raw - size_to_move,
+                            size_to_move);
+                }
+                /* and this slot is now emtpy. */
+                *metadata_target = 0;
+                --control->cur_items;
+
+                if (control->max_items == 0
+                    && control->cur_items < control->max_probe_distance) {
+                    /* As for MVMPtrHashTable, resetting this here is merely an
+                     * optimisation (to avoid a doubling). */
+                    MVMuint32 official_size = 1 << (MVMuint32)control->official_size_log2;
+                    control->max_items = official_size * MVM_INT_HASH_LOAD_FACTOR;
+                }
+
+                /* Job's a good 'un. */
+                return 1;
+            }
+        }
+        /* There's a sentinel at the end. This will terminate: */
+        else if (*ls.metadata < ls.probe_distance) {
+            /* Not in the hash. */
+            return 0;
+        }
+        ls.probe_distance += ls.metadata_increment;
+        ++ls.metadata;
+        ls.entry_raw -= ls.entry_size;
+        assert(ls.probe_distance <= (control->max_probe_distance + 1) * ls.metadata_increment);
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + MVM_int_hash_max_items(control));
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + 256);
+    }
+}
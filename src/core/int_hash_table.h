@@ -0,0 +1,46 @@
+/* A hash table keyed on native 64 bit integers, with a register sized value.
+
+This is the same Robin Hood design as MVMPtrHashTable (see the comments in
+ptr_hash_table.h) with the entries descending in memory below the control
+structure, and the metadata ascending above it. It differs in that
+
+* the keys are 64 bits wide on all platforms, and are not pointers, so can be
+  chosen by the user. Hence a random salt is mixed in before the Fibonacci
+  hashing, as for MVMStrHashTable.
+* 0 is a valid key, so it can't signal a freshly created entry. Instead
+  MVM_int_hash_lvalue_fetch reports that through a flag.
+* there are iterators, and a delete that doesn't return the value.
+* as the table is used by the IntHash REPR, on growth the old memory is freed at
+  the next safe point, so that erroneous concurrent use from another thread
+  can't crash the VM.
+*/
+
+struct MVMIntHashTableControl {
+    MVMuint64 salt;
+    MVMHashNumItems cur_items;
+    MVMHashNumItems max_items; /* hit this and we grow */
+    MVMuint8 official_size_log2;
+    MVMuint8 key_right_shift;
+    /* This is the maximum probe distance we can use without updating the
+     * metadata. It might not *yet* be the maximum probe distance possible for
+     * the official_size. */
+    MVMuint8 max_probe_distance;
+    /* This is the maximum probe distance possible for the official size.
+     * We can (re)calcuate this from other values in the struct, but it's easier
+     * to cache it as we have the space. */
+    MVMuint8 max_probe_distance_limit;
+    MVMuint8 metadata_hash_bits;
+};
+
+struct MVMIntHashTable {
+    struct MVMIntHashTableControl *table;
+};
+
+struct MVMIntHashEntry {
+    MVMint64 key;
+    MVMRegister value;
+};
+
+typedef struct {
+    MVMuint32 pos;
+} MVMIntHashIterator;
@@ -0,0 +1,211 @@
+/* These are private. We need them out here for the inline functions. Use those.
+ */
+/* See comments in hash_allocate_common (and elsewhere) before changing the
+ * load factor, or INT_INITIAL_SIZE_LOG2 or MVM_HASH_INITIAL_BITS_IN_METADATA,
+ * and test with assertions enabled. The current choices permit certain
+ * optimisation assumptions in parts of the code. */
+#define MVM_INT_HASH_LOAD_FACTOR 0.75
+MVM_STATIC_INLINE MVMuint32 MVM_int_hash_official_size(const struct MVMIntHashTableControl *control) {
+    return 1 << (MVMuint32)control->official_size_log2;
+}
+/* -1 because...
+ * probe distance of 1 is the correct bucket.
+ * hence for a value whose ideal slot is the last bucket, it's *in* the official
+ * allocation.
+ * probe distance of 2 is the first extra bucket beyond the official allocation
+ * probe distance of 255 is the 254th beyond the official allocation.
+ */
+MVM_STATIC_INLINE MVMuint32 MVM_int_hash_allocated_items(const struct MVMIntHashTableControl *control) {
+    return MVM_int_hash_official_size(control) + control->max_probe_distance_limit - 1;
+}
+MVM_STATIC_INLINE MVMuint32 MVM_int_hash_max_items(const struct MVMIntHashTableControl *control) {
+    return MVM_int_hash_official_size(control) * MVM_INT_HASH_LOAD_FACTOR;
+}
+/* Returns the number of buckets that the hash is using. As for
+ * MVM_str_hash_kompromat, this function is private. */
+MVM_STATIC_INLINE MVMuint32 MVM_int_hash_kompromat(const struct MVMIntHashTableControl *control) {
+    if (MVM_UNLIKELY(control->cur_items == 0))
+        return 0;
+    return MVM_int_hash_official_size(control) + control->max_probe_distance - 1;
+}
+MVM_STATIC_INLINE MVMuint8 *MVM_int_hash_metadata(const struct MVMIntHashTableControl *control) {
+    return (MVMuint8 *) control + sizeof(struct MVMIntHashTableControl);
+}
+MVM_STATIC_INLINE MVMuint8 *MVM_int_hash_entries(const struct MVMIntHashTableControl *control) {
+    return (MVMuint8 *) control - sizeof(struct MVMIntHashEntry);
+}
+
+MVM_STATIC_INLINE size_t MVM_int_hash_allocated_size(MVMThreadContext *tc, MVMIntHashTable *hashtable) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    if (!control)
+        return 0;
+
+    size_t allocated_items = MVM_int_hash_allocated_items(control);
+    size_t entries_size = sizeof(struct MVMIntHashEntry) * allocated_items;
+    size_t metadata_size = MVM_hash_round_size_up(allocated_items + 1);
+    return entries_size + sizeof(struct MVMIntHashTableControl) + metadata_size;
+}
+
+/* Frees the entire contents of the hash, leaving you just the hashtable itself,
+   which you allocated (heap, stack, inside another struct, wherever) */
+void MVM_int_hash_demolish(MVMThreadContext *tc, MVMIntHashTable *hashtable);
+/* and then free memory if you allocated it */
+
+/* Call this before you use the hashtable, to initialise it.
+ * Doesn't allocate memory - you can embed the struct within a larger struct if
+ * you wish.
+ */
+MVM_STATIC_INLINE void MVM_int_hash_build(MVMThreadContext *tc, MVMIntHashTable *hashtable) {
+    hashtable->table = NULL;
+}
+
+MVM_STATIC_INLINE int MVM_int_hash_is_empty(MVMThreadContext *tc,
+                                            MVMIntHashTable *hashtable) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    return !control || control->cur_items == 0;
+}
+
+MVM_STATIC_INLINE MVMHashNumItems MVM_int_hash_count(MVMThreadContext *tc,
+                                                     MVMIntHashTable *hashtable) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    return control ? control->cur_items : 0;
+}
+
+/* This code assumes that the destination hash is uninitialised - ie not even
+ * MVM_int_hash_build has been called upon it. */
+void MVM_int_hash_shallow_copy(MVMThreadContext *tc,
+                               MVMIntHashTable *source,
+                               MVMIntHashTable *dest);
+
+/* Fibonacci bucket determination, as for MVMPtrHashTable. Unlike pointers,
+ * these keys are under the control of the user, so we mix in the salt first,
+ * as MVM_str_hash_code does. */
+MVM_STATIC_INLINE MVMuint64 MVM_int_hash_code(MVMuint64 salt, MVMint64 key) {
+    return ((MVMuint64)key ^ salt) * UINT64_C(11400714819323198485);
+}
+
+MVM_STATIC_INLINE struct MVM_hash_loop_state
+MVM_int_hash_create_loop_state(struct MVMIntHashTableControl *control,
+                               MVMint64 key) {
+    struct MVM_hash_loop_state retval;
+    retval.entry_size = sizeof(struct MVMIntHashEntry);
+    retval.metadata_increment = 1 << control->metadata_hash_bits;
+    retval.metadata_hash_mask = retval.metadata_increment - 1;
+    retval.probe_distance_shift = control->metadata_hash_bits;
+    retval.max_probe_distance = control->max_probe_distance;
+
+    unsigned int used_hash_bits
+        = MVM_int_hash_code(control->salt, key) >> control->key_right_shift;
+    retval.probe_distance = retval.metadata_increment | (used_hash_bits & retval.metadata_hash_mask);
+    MVMHashNumItems bucket = used_hash_bits >> control->metadata_hash_bits;
+    if (!control->metadata_hash_bits) {
+        assert(retval.probe_distance == 1);
+        assert(retval.metadata_hash_mask == 0);
+        assert(bucket == used_hash_bits);
+    }
+
+    retval.entry_raw = MVM_int_hash_entries(control) - bucket * retval.entry_size;
+    retval.metadata = MVM_int_hash_metadata(control) + bucket;
+    return retval;
+}
+
+MVM_STATIC_INLINE struct MVMIntHashEntry *MVM_int_hash_fetch(MVMThreadContext *tc,
+                                                             MVMIntHashTable *hashtable,
+                                                             MVMint64 key) {
+    if (MVM_int_hash_is_empty(tc, hashtable)) {
+        return NULL;
+    }
+
+    struct MVMIntHashTableControl *control = hashtable->table;
+    struct MVM_hash_loop_state ls = MVM_int_hash_create_loop_state(control, key);
+
+    while (1) {
+        if (*ls.metadata == ls.probe_distance) {
+            struct MVMIntHashEntry *entry = (struct MVMIntHashEntry *) ls.entry_raw;
+            if (entry->key == key) {
+                return entry;
+            }
+        }
+        /* There's a sentinel at the end. This will terminate: */
+        else if (*ls.metadata < ls.probe_distance) {
+            /* So, if we hit 0, the bucket is empty. "Not found".
+               If we hit something with a lower probe distance then the key we
+               seek can't be in the hash table - see the comments in
+               MVM_str_hash_fetch_nocheck. */
+            return NULL;
+        }
+        ls.probe_distance += ls.metadata_increment;
+        ++ls.metadata;
+        ls.entry_raw -= ls.entry_size;
+        assert(ls.probe_distance < (ls.max_probe_distance + 2) * ls.metadata_increment);
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + MVM_int_hash_max_items(control));
+        assert(ls.metadata < MVM_int_hash_metadata(control) + MVM_int_hash_official_size(control) + 256);
+    }
+}
+
+/* Looks up the entry for key, creating it if necessary, in which case *created
+ * is set to 1 and the value is zeroed (so a NULL object or string, or 0.) */
+struct MVMIntHashEntry *MVM_int_hash_lvalue_fetch(MVMThreadContext *tc,
+                                                  MVMIntHashTable *hashtable,
+                                                  MVMint64 key,
+                                                  int *created);
+
+/* Returns 1 if the key was present (and so was deleted), 0 if not. Deleting
+ * the entry at an iterator is permitted (and the iterator may then be advanced
+ * with MVM_int_hash_next) but no other mutation is during iteration. */
+int MVM_int_hash_delete(MVMThreadContext *tc,
+                        MVMIntHashTable *hashtable,
+                        MVMint64 key);
+
+/* iterators are stored as unsigned values, metadata index plus one.
+ * This is clearly an internal implementation detail. Don't cheat.
+ */
+
+MVM_STATIC_INLINE int MVM_int_hash_at_end(MVMThreadContext *tc,
+                                          MVMIntHashTable *hashtable,
+                                          MVMIntHashIterator iterator) {
+    return iterator.pos == 0;
+}
+
+/* Only call this if MVM_int_hash_at_end returns false. */
+MVM_STATIC_INLINE MVMIntHashIterator MVM_int_hash_next(MVMThreadContext *tc,
+                                                       MVMIntHashTable *hashtable,
+                                                       MVMIntHashIterator iterator) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    MVMuint8 *metadata = MVM_int_hash_metadata(control);
+    while (--iterator.pos > 0) {
+        if (metadata[iterator.pos - 1]) {
+            return iterator;
+        }
+        iterator.pos -= MVM_hash_empty_run_before(metadata + iterator.pos - 1,
+                                                  iterator.pos - 1);
+    }
+    return iterator;
+}
+
+MVM_STATIC_INLINE MVMIntHashIterator MVM_int_hash_first(MVMThreadContext *tc,
+                                                        MVMIntHashTable *hashtable) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    MVMIntHashIterator iterator;
+
+    if (!control || control->cur_items == 0) {
+        iterator.pos = 0;
+        return iterator;
+    }
+
+    iterator.pos = MVM_int_hash_kompromat(control);
+    if (MVM_int_hash_metadata(control)[iterator.pos - 1]) {
+        return iterator;
+    }
+    return MVM_int_hash_next(tc, hashtable, iterator);
+}
+
+/* Only call this if MVM_int_hash_at_end returns false. */
+MVM_STATIC_INLINE struct MVMIntHashEntry *MVM_int_hash_current(MVMThreadContext *tc,
+                                                               MVMIntHashTable *hashtable,
+                                                               MVMIntHashIterator iterator) {
+    struct MVMIntHashTableControl *control = hashtable->table;
+    assert(MVM_int_hash_metadata(control)[iterator.pos - 1]);
+    return (struct MVMIntHashEntry *) (MVM_int_hash_entries(control)
+                                       - sizeof(struct MVMIntHashEntry) * (iterator.pos - 1));
+}
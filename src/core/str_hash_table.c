@@ -33,9 +33,7 @@ MVM_STATIC_INLINE void hash_demolish_internal(MVMThreadContext *tc,
         return;
     }
 
-    size_t allocated_items = MVM_str_hash_allocated_items(control);
-    size_t entries_size = control->entry_size * allocated_items;
-    char *start = (char *)control - entries_size;
+    char *start = (char *)control - MVM_str_hash_entries_size(control);
     MVM_free_at_safepoint(tc, start);
 }
 
@@ -155,6 +153,34 @@ MVM_STATIC_INLINE struct MVMStrHashTableControl *hash_allocate_common(MVMThreadC
     return control;
 }
 
+/* A compact hash is laid out like the full table, but with the entries packed
+ * into the first `cur_items` slots in the order they were inserted, and an
+ * array of 32 bit hash codes in place of the metadata. It has no load factor
+ * and no probe distances - it is full when `cur_items` reaches `max_items`.
+ * With no entries allowed, this is just the control structure. */
+static struct MVMStrHashTableControl *hash_allocate_compact(MVMThreadContext *tc,
+                                                            MVMuint8 entry_size,
+                                                            MVMuint32 max_items) {
+    size_t entries_size = (size_t) entry_size * max_items;
+    size_t codes_size = MVM_hash_round_size_up(max_items * sizeof(MVMuint32));
+    size_t total_size
+        = entries_size + sizeof(struct MVMStrHashTableControl) + codes_size;
+
+    struct MVMStrHashTableControl *control =
+        (struct MVMStrHashTableControl *) ((char *) MVM_malloc(total_size) + entries_size);
+
+    /* official_size_log2 of 0 is what marks the hash as compact. */
+    memset(control, 0, sizeof(*control));
+    control->max_items = max_items;
+    control->entry_size = entry_size;
+#if MVM_HASH_RANDOMIZE
+    control->salt = MVM_proc_rand_i(tc);
+#endif
+    assert(MVM_str_hash_is_compact(control));
+
+    return control;
+}
+
 void MVM_str_hash_build(MVMThreadContext *tc,
                         MVMStrHashTable *hashtable,
                         MVMuint32 entry_size,
@@ -165,15 +191,12 @@ void MVM_str_hash_build(MVMThreadContext *tc,
     }
 
     struct MVMStrHashTableControl *control;
-    if (!entries) {
-        control = MVM_malloc(sizeof(*control));
-        /* cur_items and max_items both 0 signals that we only allocated a
-         * control structure. */
-        memset(control, 0, sizeof(*control));
-        control->entry_size = entry_size;
-#if MVM_HASH_RANDOMIZE
-        control->salt = MVM_proc_rand_i(tc);
-#endif
+    if (entries <= MVM_STR_HASH_COMPACT_MAX_ITEMS) {
+        /* Round up to even, so that the control structure that follows the
+         * entries stays 8 byte aligned. For no entries, cur_items and
+         * max_items both 0 signals that we only allocated a control
+         * structure. */
+        control = hash_allocate_compact(tc, entry_size, (entries + 1) & ~1);
     } else {
         /* Minimum size we need to allocate, given the load factor. */
         MVMuint32 min_needed = entries * (1.0 / MVM_STR_HASH_LOAD_FACTOR);
@@ -318,27 +341,129 @@ MVM_STATIC_INLINE struct MVMStrHashHandle *hash_insert_internal(MVMThreadContext
     }
 }
 
+MVM_STATIC_INLINE struct MVMStrHashHandle *compact_insert_internal(MVMThreadContext *tc,
+                                                                   struct MVMStrHashTableControl *control,
+                                                                   MVMString *key) {
+    MVMint32 found = MVM_str_hash_compact_find(tc, control, key);
+    if (found >= 0) {
+        return (struct MVMStrHashHandle *)
+            (MVM_str_hash_entries(control) - found * control->entry_size);
+    }
+
+    if (MVM_UNLIKELY(control->cur_items >= control->max_items)) {
+        MVM_oops(tc, "oops, compact_insert_internal has no space (%"PRIu32" >= %"PRIu32" when adding %p",
+                 control->cur_items, control->max_items, key);
+    }
+
+    MVMuint32 index = control->cur_items++;
+#if HASH_DEBUG_ITER
+    ++control->serial;
+    control->last_delete_at = 0;
+#endif
+
+    MVM_str_hash_compact_codes(control)[index] = MVM_str_hash_compact_code(tc, key);
+    struct MVMStrHashHandle *entry = (struct MVMStrHashHandle *)
+        (MVM_str_hash_entries(control) - index * control->entry_size);
+    entry->key = NULL;
+    return entry;
+}
+
+static struct MVMStrHashTableControl *maybe_grow_hash(MVMThreadContext *tc,
+                                                      struct MVMStrHashTableControl *control);
+
+/* Inserts a copy of an entry from the table being grown into the new table,
+ * growing that further if it turns out to be necessary. Returns the (possibly
+ * new) control structure. */
+MVM_STATIC_INLINE struct MVMStrHashTableControl *hash_move_entry(MVMThreadContext *tc,
+                                                                 struct MVMStrHashTableControl *control,
+                                                                 MVMuint8 *entry_raw) {
+    MVMuint8 entry_size = control->entry_size;
+    struct MVMStrHashHandle *old_entry = (struct MVMStrHashHandle *) entry_raw;
+    void *new_entry_raw = hash_insert_internal(tc, control, old_entry->key);
+    struct MVMStrHashHandle *new_entry = (struct MVMStrHashHandle *) new_entry_raw;
+    assert(new_entry->key == NULL);
+    if (MVM_LIKELY(entry_size == sizeof(MVMHashEntry))) {
+        /* The `memcpy` in the else is equivalent to this, and quite
+         * possibly its implementation starts with a jump-table based on
+         * size. I'd just like to give the compiler an enormous hint that
+         * the pointers are going to be word aligned, and that "two
+         * pointers" is the most common size. */
+        MVMHashEntry *from = (MVMHashEntry *) entry_raw;
+        MVMHashEntry *to = (MVMHashEntry *) new_entry_raw;
+        *to = *from;
+    } else {
+        memcpy(new_entry, old_entry, entry_size);
+    }
+
+    if (!control->max_items) {
+        /* Probably we hit the probe limit.
+         * But it's just possible that one actual "grow" wasn't enough.
+         */
+        struct MVMStrHashTableControl *new_control
+            = maybe_grow_hash(tc, control);
+        if (new_control) {
+            control = new_control;
+        } else {
+            /* else we expanded the probe distance and life is easy. */
+        }
+    }
+    return control;
+}
+
 static struct MVMStrHashTableControl *maybe_grow_hash(MVMThreadContext *tc,
                                                       struct MVMStrHashTableControl *control) {
-    if (MVM_UNLIKELY(control->cur_items == 0 && control->max_items == 0)) {
-        /* This is the case where we had initially allocated just a control
-         * structure, and now we find that we need to allocate some memory for
-         * the first entry. Which implies that we've had no insertions or
-         * deletions prior to this, hence our debugging state must be (0, 0) */
+    if (MVM_str_hash_is_compact(control)) {
+        /* A compact hash that is full, which includes the case where we had
+         * initially allocated just a control structure. Either give it more
+         * room, or once it has reached MVM_STR_HASH_COMPACT_MAX_ITEMS, switch
+         * to the full table. */
         struct MVMStrHashTableControl *control_orig = control;
+        MVMuint32 cur_items = control_orig->cur_items;
+        MVMuint8 entry_size = control_orig->entry_size;
 
         control_orig->stale = 1;
-        control = hash_allocate_common(tc,
-                                       control_orig->entry_size,
-                                       STR_MIN_SIZE_BASE_2);
+        if (control_orig->max_items < MVM_STR_HASH_COMPACT_MAX_ITEMS) {
+            MVMuint32 max_items = control_orig->max_items ? 2 * control_orig->max_items : 4;
+            if (max_items > MVM_STR_HASH_COMPACT_MAX_ITEMS) {
+                max_items = MVM_STR_HASH_COMPACT_MAX_ITEMS;
+            }
+            control = hash_allocate_compact(tc, entry_size, max_items);
+            control->salt = control_orig->salt;
+            control->cur_items = cur_items;
+            if (cur_items) {
+                /* The entries are packed immediately below the control
+                 * structure, so copy them as one block. */
+                size_t entries_size = (size_t) entry_size * cur_items;
+                memcpy((MVMuint8 *) control - entries_size,
+                       (MVMuint8 *) control_orig - entries_size,
+                       entries_size);
+                memcpy(MVM_str_hash_compact_codes(control),
+                       MVM_str_hash_compact_codes(control_orig),
+                       cur_items * sizeof(MVMuint32));
+            }
+        } else {
+            MVMuint32 min_needed = (cur_items + 1) * (1.0 / MVM_STR_HASH_LOAD_FACTOR);
+            MVMuint32 initial_size_base2 = MVM_round_up_log_base2(min_needed);
+            if (initial_size_base2 < STR_MIN_SIZE_BASE_2) {
+                initial_size_base2 = STR_MIN_SIZE_BASE_2;
+            }
+            control = hash_allocate_common(tc, entry_size, initial_size_base2);
+
+            MVMuint8 *entry_raw = MVM_str_hash_entries(control_orig);
+            MVMuint32 index;
+            for (index = 0; index < cur_items; ++index) {
+                control = hash_move_entry(tc, control, entry_raw);
+                entry_raw -= entry_size;
+            }
+        }
+
 #if HASH_DEBUG_ITER
         control->ht_id = control_orig->ht_id;
-        assert(control_orig->serial == 0);
-        assert(control_orig->last_delete_at == 0);
-        control->serial = 0;
-        control->last_delete_at = 0;
+        control->serial = control_orig->serial;
+        control->last_delete_at = control_orig->last_delete_at;
 #endif
-        MVM_free_at_safepoint(tc, control_orig);
+        MVM_free_at_safepoint(tc, (char *) control_orig - MVM_str_hash_entries_size(control_orig));
+        assert(control->max_items);
         return control;
     }
 
@@ -412,35 +537,7 @@ static struct MVMStrHashTableControl *maybe_grow_hash(MVMThreadContext *tc,
     MVMHashNumItems bucket = 0;
     while (bucket < entries_in_use) {
         if (*metadata) {
-            struct MVMStrHashHandle *old_entry = (struct MVMStrHashHandle *) entry_raw;
-            void *new_entry_raw = hash_insert_internal(tc, control, old_entry->key);
-            struct MVMStrHashHandle *new_entry = (struct MVMStrHashHandle *) new_entry_raw;
-            assert(new_entry->key == NULL);
-            if (MVM_LIKELY(entry_size == sizeof(MVMHashEntry))) {
-                /* The `memcpy` in the else is equivalent to this, and quite
-                 * possibly its implementation starts with a jump-table based on
-                 * size. I'd just like to give the compiler an enormous hint that
-                 * the pointers are going to be word aligned, and that "two
-                 * pointers" is the most common size. */
-                MVMHashEntry *from = (MVMHashEntry *) entry_raw;
-                MVMHashEntry *to = (MVMHashEntry *) new_entry_raw;
-                *to = *from;
-            } else {
-                memcpy(new_entry, old_entry, entry_size);
-            }
-
-            if (!control->max_items) {
-                /* Probably we hit the probe limit.
-                 * But it's just possible that one actual "grow" wasn't enough.
-                 */
-                struct MVMStrHashTableControl *new_control
-                    = maybe_grow_hash(tc, control);
-                if (new_control) {
-                    control = new_control;
-                } else {
-                    /* else we expanded the probe distance and life is easy. */
-                }
-            }
+            control = hash_move_entry(tc, control, entry_raw);
         }
         ++bucket;
         ++metadata;
@@ -489,7 +586,9 @@ void *MVM_str_hash_lvalue_fetch_nocheck(MVMThreadContext *tc,
         }
     }
 
-    void *result = hash_insert_internal(tc, control, key);
+    void *result = MVM_str_hash_is_compact(control)
+        ? compact_insert_internal(tc, control, key)
+        : hash_insert_internal(tc, control, key);
     if (MVM_UNLIKELY(control->stale)) {
         MVM_oops(tc, "MVM_str_hash_lvalue_fetch_nocheck called with a hashtable pointer that turned stale");
     }
@@ -529,6 +628,38 @@ void MVM_str_hash_delete_nocheck(MVMThreadContext *tc,
         return;
     }
 
+    if (MVM_str_hash_is_compact(control)) {
+        MVMint32 found = MVM_str_hash_compact_find(tc, control, key);
+        if (found >= 0) {
+            /* Close the gap by moving the entries after it down one, which
+             * keeps them in order. As iterators work from the last entry to
+             * the first, any that are moved have already been visited, so it
+             * is still safe to delete the entry at an iterator. */
+            MVMuint32 entries_to_move = control->cur_items - found - 1;
+            if (entries_to_move) {
+                size_t size_to_move = (size_t) control->entry_size * entries_to_move;
+                MVMuint8 *entry_raw = MVM_str_hash_entries(control) - found * control->entry_size;
+                /* Entries are descending in memory, so those after it are
+                 * below it. */
+                memmove(entry_raw - size_to_move + control->entry_size,
+                        entry_raw - size_to_move,
+                        size_to_move);
+                MVMuint32 *codes = MVM_str_hash_compact_codes(control);
+                memmove(codes + found, codes + found + 1,
+                        entries_to_move * sizeof(MVMuint32));
+            }
+            --control->cur_items;
+#if HASH_DEBUG_ITER
+            ++control->serial;
+            control->last_delete_at = 1 + found;
+#endif
+        }
+        if (MVM_UNLIKELY(control->stale)) {
+            MVM_oops(tc, "MVM_str_hash_delete_nocheck called with a hashtable pointer that turned stale");
+        }
+        return;
+    }
+
     struct MVM_hash_loop_state ls = MVM_str_hash_create_loop_state(tc, control, key);
 
     while (1) {
@@ -711,6 +842,31 @@ static MVMuint64 hash_fsck_internal(MVMThreadContext *tc, struct MVMStrHashTable
         return 0;
     }
 
+    if (MVM_str_hash_is_compact(control)) {
+        MVMuint8 *entry_raw = MVM_str_hash_entries(control);
+        MVMuint32 *codes = MVM_str_hash_compact_codes(control);
+        MVMuint32 index;
+        for (index = 0; index < control->cur_items; ++index) {
+            MVMString *key = ((struct MVMStrHashHandle *) entry_raw)->key;
+            entry_raw -= control->entry_size;
+            if (!key || (MVMObject *)key == tc->instance->VMNull
+                || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key)) {
+                ++errors;
+                if (display) {
+                    fprintf(stderr, "%s%3X! bad key %p\n", prefix_hashes, index, key);
+                }
+                continue;
+            }
+            char wrong_code = codes[index] == MVM_str_hash_compact_code(tc, key) ? ' ' : '!';
+            errors += wrong_code != ' ';
+            if (display == 2 || (display == 1 && wrong_code != ' ')) {
+                fprintf(stderr, "%s%3X%c%08"PRIx32" %p\n", prefix_hashes, index,
+                        wrong_code, codes[index], key);
+            }
+        }
+        return errors;
+    }
+
     MVMuint32 allocated_items = MVM_str_hash_allocated_items(control);
     const MVMuint8 metadata_hash_bits = control->metadata_hash_bits;
     MVMuint8 *entry_raw = MVM_str_hash_entries(control);
@@ -427,6 +427,8 @@ struct MVMStrHashTableControl {
      * result, and insert will immediately allocate the default minimum size. */
     MVMHashNumItems cur_items;
     MVMHashNumItems max_items; /* hit this and we grow */
+    /* 0 for a compact hash, which has no metadata and most of the fields
+     * below unused. See hash_allocate_compact in str_hash_table.c */
     MVMuint8 official_size_log2;
     MVMuint8 key_right_shift;
     MVMuint8 entry_size;
@@ -5,12 +5,26 @@
  * and test with assertions enabled. The current choices permit certain
  * optimisation assumptions in parts of the code. */
 #define MVM_STR_HASH_LOAD_FACTOR 0.75
+/* Hashes with no more than this many entries are kept compact. See the
+ * comments in str_hash_table.h */
+#define MVM_STR_HASH_COMPACT_MAX_ITEMS 8
+MVM_STATIC_INLINE int MVM_str_hash_is_compact(const struct MVMStrHashTableControl *control) {
+    return control->official_size_log2 == 0;
+}
+MVM_STATIC_INLINE MVMuint32 *MVM_str_hash_compact_codes(const struct MVMStrHashTableControl *control) {
+    assert(MVM_str_hash_is_compact(control));
+    return (MVMuint32 *) ((MVMuint8 *) control + sizeof(struct MVMStrHashTableControl));
+}
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_compact_code(MVMThreadContext *tc,
+                                                      MVMString *key) {
+    return (MVMuint32) (MVM_string_hash_code(tc, key) >> 32);
+}
 MVM_STATIC_INLINE MVMuint32 MVM_str_hash_official_size(const struct MVMStrHashTableControl *control) {
-    assert(!(control->cur_items == 0 && control->max_items == 0));
+    assert(!MVM_str_hash_is_compact(control));
     return 1 << (MVMuint32)control->official_size_log2;
 }
 MVM_STATIC_INLINE MVMuint32 MVM_str_hash_max_items(const struct MVMStrHashTableControl *control) {
-    assert(!(control->cur_items == 0 && control->max_items == 0));
+    assert(!MVM_str_hash_is_compact(control));
     return MVM_str_hash_official_size(control) * MVM_STR_HASH_LOAD_FACTOR;
 }
 /* -1 because...
@@ -21,7 +35,7 @@ MVM_STATIC_INLINE MVMuint32 MVM_str_hash_max_items(const struct MVMStrHashTableC
  * probe distance of 255 is the 254th beyond the official allocation.
  */
 MVM_STATIC_INLINE MVMuint32 MVM_str_hash_allocated_items(const struct MVMStrHashTableControl *control) {
-    assert(!(control->cur_items == 0 && control->max_items == 0));
+    assert(!MVM_str_hash_is_compact(control));
     return MVM_str_hash_official_size(control) + control->max_probe_distance_limit - 1;
 }
 /* Returns the number of buckets that the hash is using. This can be lower than
@@ -30,16 +44,16 @@ MVM_STATIC_INLINE MVMuint32 MVM_str_hash_allocated_items(const struct MVMStrHash
  * max_probe_distance_limit - 1. And if the hash is empty, it can't be using
  * any buckets. As the name is meant to imply, this function is private. */
 MVM_STATIC_INLINE MVMuint32 MVM_str_hash_kompromat(const struct MVMStrHashTableControl *control) {
-    if (MVM_UNLIKELY(control->cur_items == 0))
-        return 0;
+    if (MVM_UNLIKELY(control->cur_items == 0) || MVM_str_hash_is_compact(control))
+        return control->cur_items;
     return MVM_str_hash_official_size(control) + control->max_probe_distance - 1;
 }
 MVM_STATIC_INLINE MVMuint8 *MVM_str_hash_metadata(const struct MVMStrHashTableControl *control) {
-    assert(!(control->cur_items == 0 && control->max_items == 0));
+    assert(!MVM_str_hash_is_compact(control));
     return (MVMuint8 *) control + sizeof(struct MVMStrHashTableControl);
 }
 MVM_STATIC_INLINE MVMuint8 *MVM_str_hash_entries(const struct MVMStrHashTableControl *control) {
-    assert(!(control->cur_items == 0 && control->max_items == 0));
+    assert(control->max_items || !MVM_str_hash_is_compact(control));
     return (MVMuint8 *) control - control->entry_size;
 }
 
@@ -51,6 +65,50 @@ MVM_STATIC_INLINE size_t MVM_hash_round_size_up(size_t wanted) {
     return (wanted - 1 + sizeof(long)) & ~(sizeof(long) - 1);
 }
 
+/* The number of bytes allocated for entries (below the control structure) and
+ * for metadata or hash codes (above it). For the initial empty allocation of
+ * just the control structure, both are 0. */
+MVM_STATIC_INLINE size_t MVM_str_hash_entries_size(const struct MVMStrHashTableControl *control) {
+    if (MVM_str_hash_is_compact(control))
+        return (size_t) control->entry_size * control->max_items;
+    return (size_t) control->entry_size * MVM_str_hash_allocated_items(control);
+}
+MVM_STATIC_INLINE size_t MVM_str_hash_metadata_size(const struct MVMStrHashTableControl *control) {
+    if (MVM_str_hash_is_compact(control))
+        return MVM_hash_round_size_up(control->max_items * sizeof(MVMuint32));
+    return MVM_hash_round_size_up(MVM_str_hash_allocated_items(control) + 1);
+}
+
+/* The metadata byte of an empty bucket is 0. Loops that visit every bucket
+ * use these to step over runs of empty buckets a word at a time, rather than
+ * testing each byte in turn. As only whole words of zeroes are skipped,
+ * endianness doesn't matter. They return how many buckets (a multiple of the
+ * word size, possibly 0) are known to be empty starting at `metadata`, or
+ * ending just before it, looking at no more than `limit` buckets so as never
+ * to read beyond the metadata. */
+MVM_STATIC_INLINE MVMuint32 MVM_hash_empty_run(const MVMuint8 *metadata, MVMuint32 limit) {
+    MVMuint32 run = 0;
+    unsigned long word;
+    while (run + sizeof(word) <= limit) {
+        memcpy(&word, metadata + run, sizeof(word));
+        if (word)
+            break;
+        run += sizeof(word);
+    }
+    return run;
+}
+MVM_STATIC_INLINE MVMuint32 MVM_hash_empty_run_before(const MVMuint8 *metadata, MVMuint32 limit) {
+    MVMuint32 run = 0;
+    unsigned long word;
+    while (run + sizeof(word) <= limit) {
+        memcpy(&word, metadata - run - sizeof(word), sizeof(word));
+        if (word)
+            break;
+        run += sizeof(word);
+    }
+    return run;
+}
+
 MVM_STATIC_INLINE size_t MVM_str_hash_allocated_size(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
     struct MVMStrHashTableControl *control = hashtable->table;
     if (!control)
@@ -59,13 +117,8 @@ MVM_STATIC_INLINE size_t MVM_str_hash_allocated_size(MVMThreadContext *tc, MVMSt
         MVM_oops(tc, "MVM_str_hash_allocated_size called with a stale hashtable pointer");
     }
 
-    if (control->cur_items == 0 && control->max_items == 0)
-        return sizeof(*control);
-
-    size_t allocated_items = MVM_str_hash_allocated_items(control);
-    size_t entries_size = control->entry_size * allocated_items;
-    size_t metadata_size = MVM_hash_round_size_up(allocated_items + 1);
-    return entries_size + sizeof(struct MVMStrHashTableControl) + metadata_size;
+    return MVM_str_hash_entries_size(control) + sizeof(struct MVMStrHashTableControl)
+        + MVM_str_hash_metadata_size(control);
 }
 
 /* Frees the entire contents of the hash, leaving you just the hashtable itself,
@@ -104,9 +157,8 @@ MVM_STATIC_INLINE void MVM_str_hash_shallow_copy(MVMThreadContext *tc,
         memcpy(empty, control, sizeof(*empty));
         dest->table = empty;
     } else {
-        size_t allocated_items = MVM_str_hash_allocated_items(control);
-        size_t entries_size = control->entry_size * allocated_items;
-        size_t metadata_size = MVM_hash_round_size_up(allocated_items + 1);
+        size_t entries_size = MVM_str_hash_entries_size(control);
+        size_t metadata_size = MVM_str_hash_metadata_size(control);
         const char *start = (const char *)control - entries_size;
         size_t total_size
             = entries_size + sizeof(struct MVMStrHashTableControl) + metadata_size;
@@ -181,6 +233,31 @@ MVM_str_hash_create_loop_state(MVMThreadContext *tc,
     return retval;
 }
 
+/* Compact hashes are searched linearly. The hash codes are compared first, so
+ * that only the keys of likely matches need to be looked at. Returns the index
+ * of the entry for the key, or -1 if there isn't one. */
+MVM_STATIC_INLINE MVMint32 MVM_str_hash_compact_find(MVMThreadContext *tc,
+                                                     const struct MVMStrHashTableControl *control,
+                                                     MVMString *key) {
+    MVMuint32 code = MVM_str_hash_compact_code(tc, key);
+    const MVMuint32 *codes = MVM_str_hash_compact_codes(control);
+    MVMuint32 i;
+    for (i = 0; i < control->cur_items; ++i) {
+        if (codes[i] == code) {
+            struct MVMStrHashHandle *entry = (struct MVMStrHashHandle *)
+                (MVM_str_hash_entries(control) - i * control->entry_size);
+            if (entry->key == key
+                || (MVM_string_graphs_nocheck(tc, key) == MVM_string_graphs_nocheck(tc, entry->key)
+                    && MVM_string_substrings_equal_nocheck(tc, key, 0,
+                                                           MVM_string_graphs_nocheck(tc, key),
+                                                           entry->key, 0))) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
 MVM_STATIC_INLINE void *MVM_str_hash_fetch_nocheck(MVMThreadContext *tc,
                                                    MVMStrHashTable *hashtable,
                                                    MVMString *key) {
@@ -194,6 +271,14 @@ MVM_STATIC_INLINE void *MVM_str_hash_fetch_nocheck(MVMThreadContext *tc,
         return NULL;
     }
 
+    if (MVM_str_hash_is_compact(control)) {
+        MVMint32 i = MVM_str_hash_compact_find(tc, control, key);
+        if (MVM_UNLIKELY(control->stale)) {
+            MVM_oops(tc, "MVM_str_hash_fetch_nocheck called with a hashtable pointer that turned stale");
+        }
+        return i < 0 ? NULL : MVM_str_hash_entries(control) - i * control->entry_size;
+    }
+
     struct MVM_hash_loop_state ls = MVM_str_hash_create_loop_state(tc, control, key);
 
     /* Comments in str_hash_table.h describe the various invariants.
@@ -403,7 +488,8 @@ enum {
 
 MVMuint64 MVM_str_hash_fsck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint32 mode);
 
-/* iterators are stored as unsigned values, metadata index plus one.
+/* iterators are stored as unsigned values, metadata index plus one (or for
+ * compact hashes, entry index plus one).
  * This is clearly an internal implementation detail. Don't cheat.
  */
 
@@ -416,13 +502,22 @@ MVM_STATIC_INLINE MVMStrHashIterator MVM_str_hash_next_nocheck(MVMThreadContext
         MVM_oops(tc, "MVM_str_hash_iterator_next_nocheck called with a stale hashtable pointer");
     }
 
-    /* Whilst this looks like it can be optimised to word at a time skip ahead.
-     * (Beware of endianness) it isn't easy *yet*, because one can overrun the
-     * allocated buffer, and that makes ASAN very excited. */
+    /* Every entry of a compact hash below cur_items is in use. */
+    if (MVM_str_hash_is_compact(control)) {
+        --iterator.pos;
+        return iterator;
+    }
+
+    /* Having found an empty bucket, skip any whole words of empty buckets
+     * below it. There are `iterator.pos - 1` buckets below it, so this can't
+     * read outside of the metadata. */
+    MVMuint8 *metadata = MVM_str_hash_metadata(control);
     while (--iterator.pos > 0) {
-        if (MVM_str_hash_metadata(control)[iterator.pos - 1]) {
+        if (metadata[iterator.pos - 1]) {
             return iterator;
         }
+        iterator.pos -= MVM_hash_empty_run_before(metadata + iterator.pos - 1,
+                                                  iterator.pos - 1);
     }
     return iterator;
 }
@@ -490,7 +585,8 @@ MVM_STATIC_INLINE MVMStrHashIterator MVM_str_hash_first(MVMThreadContext *tc,
 
     iterator.pos = MVM_str_hash_kompromat(control);
 
-    if (MVM_str_hash_metadata(control)[iterator.pos - 1]) {
+    if (MVM_str_hash_is_compact(control)
+        || MVM_str_hash_metadata(control)[iterator.pos - 1]) {
         return iterator;
     }
     return MVM_str_hash_next(tc, hashtable, iterator);
@@ -555,7 +651,9 @@ MVM_STATIC_INLINE void *MVM_str_hash_current_nocheck(MVMThreadContext *tc,
         MVM_oops(tc, "MVM_str_hash_current_nocheck called with a stale hashtable pointer");
     }
 
-    assert(MVM_str_hash_metadata(control)[iterator.pos - 1]);
+    assert(MVM_str_hash_is_compact(control)
+           ? iterator.pos <= control->cur_items
+           : MVM_str_hash_metadata(control)[iterator.pos - 1]);
     return MVM_str_hash_entries(control) - control->entry_size * (iterator.pos - 1);
 }
 
@@ -105,9 +105,12 @@ static void dispatch_monomorphic(MVMThreadContext *tc,
     record->arg_info.source = source;
     record->arg_info.map = arg_indices;
     MVMint64 outcome;
+    MVMuint64 start = tc->instance->disp_stats ? uv_hrtime() : 0;
     MVMROOT2(tc, id, sf) {
         outcome = MVM_disp_program_run(tc, dp, record, cid, bytecode_offset, 0);
     }
+    if (start)
+        MVM_disp_stats_run(tc, sf, entry_ptr, uv_hrtime() - start, outcome);
     if (!outcome) {
         /* Dispatch program failed. Remove this record and then record a new
          * dispatch program. */
@@ -136,9 +139,12 @@ static void dispatch_monomorphic_flattening(MVMThreadContext *tc,
                 dp->num_temporaries);
         record->arg_info = flat_record->arg_info;
         MVMint64 outcome;
+        MVMuint64 start = tc->instance->disp_stats ? uv_hrtime() : 0;
         MVMROOT2(tc, id, sf) {
             outcome = MVM_disp_program_run(tc, dp, record, cid, bytecode_offset, 0);
         }
+        if (start)
+            MVM_disp_stats_run(tc, sf, entry_ptr, uv_hrtime() - start, outcome);
         if (outcome) {
             /* It matches, so we're ready to continue. */
             return;
@@ -176,16 +182,34 @@ static void dispatch_polymorphic(MVMThreadContext *tc,
     MVMint32 i;
     for (i = entry->num_dps - 1; i >= 0; i--) {
         MVMint64 outcome;
+        MVMuint64 start = tc->instance->disp_stats ? uv_hrtime() : 0;
         MVMROOT2(tc, id, sf) {
             outcome = MVM_disp_program_run(tc, entry->dps[i], record, cid, bytecode_offset, i);
         }
+        if (start)
+            MVM_disp_stats_run(tc, sf, entry_ptr, uv_hrtime() - start, outcome);
         if (outcome)
             return;
     }
 
-    /* If we reach here, then no program matched; run the dispatch program
-     * for another go at it. */
+    /* If we reach here, then no program matched. If the site is full, see if
+     * another megamorphic site has already recorded a program for these
+     * arguments; failing that, run the dispatch program for another go at
+     * it. */
     MVM_callstack_unwind_failed_dispatch_run(tc);
+    if (entry->num_dps == MVM_INLINE_CACHE_MAX_POLY) {
+        MVMArgs arg_info = {
+            .callsite = callsite,
+            .source = source,
+            .map = arg_indices
+        };
+        MVMint64 outcome;
+        MVMROOT2(tc, id, sf) {
+            outcome = MVM_disp_megamorphic_run(tc, MVM_disp_registry_find(tc, id), arg_info);
+        }
+        if (outcome)
+            return;
+    }
     dispatch_initial(tc, entry_ptr, seen, id, callsite, arg_indices, source, sf,
             bytecode_offset);
 }
@@ -212,18 +236,30 @@ static void dispatch_polymorphic_flattening(MVMThreadContext *tc,
     for (i = entry->num_dps - 1; i >= 0; i--) {
         if (flat_record->arg_info.callsite == entry->flattened_css[i]) {
             MVMint64 outcome;
+            MVMuint64 start = tc->instance->disp_stats ? uv_hrtime() : 0;
             MVMROOT2(tc, id, sf) {
                 outcome = MVM_disp_program_run(tc, entry->dps[i], record, cid, bytecode_offset, i);
             }
+            if (start)
+                MVM_disp_stats_run(tc, sf, entry_ptr, uv_hrtime() - start, outcome);
             if (outcome)
                 return;
         }
     }
 
     /* If we get here, then none of the callsite/dispatch program pairings
-     * matched, so we need to run the dispatch callback again. */
+     * matched. If the site is full, try the megamorphic cache, and otherwise
+     * we need to run the dispatch callback again. */
     MVM_callstack_unwind_failed_dispatch_run(tc);
     MVMDispDefinition *disp = MVM_disp_registry_find(tc, id);
+    if (entry->num_dps == MVM_INLINE_CACHE_MAX_POLY) {
+        MVMint64 outcome;
+        MVMROOT2(tc, id, sf) {
+            outcome = MVM_disp_megamorphic_run(tc, disp, flat_record->arg_info);
+        }
+        if (outcome)
+            return;
+    }
     MVM_disp_program_run_dispatch(tc, disp, flat_record->arg_info, entry_ptr, seen,
             sf);
 }
@@ -236,6 +272,24 @@ MVMuint32 MVM_disp_inline_cache_get_kind(MVMThreadContext *tc,
     return (MVMuint32)kind;
 }
 
+/* Checks if the entry is still current and has reached the maximum degree of
+ * polymorphism, meaning it won't take any further dispatch programs. */
+MVMuint32 MVM_disp_inline_cache_is_megamorphic(MVMThreadContext *tc,
+        MVMDispInlineCacheEntry **entry_ptr, MVMDispInlineCacheEntry *entry) {
+    if (*entry_ptr != entry)
+        return 0;
+    switch (MVM_disp_inline_cache_try_get_kind(tc, entry)) {
+        case MVM_INLINE_CACHE_KIND_POLYMORPHIC_DISPATCH:
+            return ((MVMDispInlineCacheEntryPolymorphicDispatch *)entry)->num_dps
+                == MVM_INLINE_CACHE_MAX_POLY;
+        case MVM_INLINE_CACHE_KIND_POLYMORPHIC_DISPATCH_FLATTENING:
+            return ((MVMDispInlineCacheEntryPolymorphicDispatchFlattening *)entry)->num_dps
+                == MVM_INLINE_CACHE_MAX_POLY;
+        default:
+            return 0;
+    }
+}
+
 MVMint32 MVM_disp_inline_cache_try_get_kind(MVMThreadContext *tc,
         MVMDispInlineCacheEntry *entry) {
     if (!entry)
@@ -284,7 +338,7 @@ static void gc_barrier_program(MVMThreadContext *tc, MVMStaticFrame *root,
     for (i = 0; i < dp->num_gc_constants; i++)
         MVM_gc_write_barrier(tc, (MVMCollectable *)root, dp->gc_constants[i]);
 }
-MVMuint32 MVM_disp_inline_cache_transition(MVMThreadContext *tc,
+static MVMuint32 transition(MVMThreadContext *tc,
         MVMDispInlineCacheEntry **entry_ptr, MVMDispInlineCacheEntry *entry,
         MVMStaticFrame *root, MVMDispDefinition *initial_disp,
         MVMCallsite *initial_cs, MVMDispProgram *dp) {
@@ -413,6 +467,16 @@ MVMuint32 MVM_disp_inline_cache_transition(MVMThreadContext *tc,
         MVM_oops(tc, "unknown transition requested for dispatch inline cache");
     }
 }
+MVMuint32 MVM_disp_inline_cache_transition(MVMThreadContext *tc,
+        MVMDispInlineCacheEntry **entry_ptr, MVMDispInlineCacheEntry *entry,
+        MVMStaticFrame *root, MVMDispDefinition *initial_disp,
+        MVMCallsite *initial_cs, MVMDispProgram *dp) {
+    MVMuint32 installed = transition(tc, entry_ptr, entry, root, initial_disp,
+            initial_cs, dp);
+    if (tc->instance->disp_stats)
+        MVM_disp_stats_transition(tc, root, entry_ptr, installed);
+    return installed;
+}
 
 /**
  * Inline caching general stuff
@@ -726,4 +790,5 @@ void MVM_disp_inline_cache_destroy(MVMThreadContext *tc, MVMDispInlineCache *cac
     for (i = 0; i < cache->num_entries; i++)
         cleanup_entry(tc, cache->entries[i], 1);
     MVM_free(cache->entries);
+    MVM_free(cache->stats);
 }
@@ -25,6 +25,9 @@ struct MVMDispInlineCache {
     /* The bit shift we should do on the instruction address in order to
      * find an entry for a instruciton. */
     MVMuint32 bit_shift;
+
+    /* Per-entry dispatch statistics, if enabled (see disp/stats.h). */
+    MVMDispStatsSite **stats;
 };
 
 /* We always invoke an action using the cache by calling a function pointer.
@@ -107,3 +110,5 @@ MVMuint32 MVM_disp_inline_cache_transition(MVMThreadContext *tc,
 void MVM_disp_inline_cache_destroy(MVMThreadContext *tc, MVMDispInlineCache *cache);
 MVMuint32 MVM_disp_inline_cache_get_kind(MVMThreadContext *tc, MVMDispInlineCacheEntry *entry);
 MVMint32 MVM_disp_inline_cache_try_get_kind(MVMThreadContext *tc, MVMDispInlineCacheEntry *entry);
+MVMuint32 MVM_disp_inline_cache_is_megamorphic(MVMThreadContext *tc,
+        MVMDispInlineCacheEntry **entry_ptr, MVMDispInlineCacheEntry *entry);
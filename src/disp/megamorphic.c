@@ -0,0 +1,198 @@
+#include "moar.h"
+
+void MVM_disp_megamorphic_init(MVMThreadContext *tc) {
+    tc->instance->disp_megamorphic.entries = MVM_calloc(MVM_DISP_MEGAMORPHIC_CACHE_SIZE,
+            sizeof(MVMDispMegamorphicEntry *));
+    tc->instance->disp_megamorphic.evicted = NULL;
+}
+
+/* Forms the key from the first two arguments. */
+static MVMuint64 make_key(MVMThreadContext *tc, MVMCallsite *cs, MVMRegister first,
+        MVMRegister second) {
+    MVMuint64 key = 0;
+    if (cs->flag_count >= 1 &&
+            (cs->arg_flags[0] & MVM_CALLSITE_ARG_TYPE_MASK) == MVM_CALLSITE_ARG_OBJ &&
+            first.o != NULL)
+        key = (MVMuint64)(uintptr_t)first.o->st;
+    if (cs->flag_count >= 2 &&
+            (cs->arg_flags[1] & MVM_CALLSITE_ARG_TYPE_MASK) == MVM_CALLSITE_ARG_STR &&
+            second.s != NULL)
+        key ^= MVM_string_hash_code(tc, second.s) * 0x9E3779B97F4A7C15ULL;
+    return key;
+}
+
+static size_t first_slot(MVMDispDefinition *disp, MVMCallsite *cs, MVMuint64 key) {
+    MVMuint64 h = key ^ ((MVMuint64)(uintptr_t)disp >> 4) ^ ((MVMuint64)(uintptr_t)cs << 7);
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 32;
+    return (size_t)(h & (MVM_DISP_MEGAMORPHIC_CACHE_SIZE - 1));
+}
+
+/* Looks for a dispatch program matching the arguments and, if there is one,
+ * tries running it. Returns a true value if it matched, in which case the
+ * dispatch is complete. On failure, the callstack is as it was before. */
+MVMint64 MVM_disp_megamorphic_run(MVMThreadContext *tc, MVMDispDefinition *disp,
+        MVMArgs arg_info) {
+    MVMDispMegamorphicEntry **entries = tc->instance->disp_megamorphic.entries;
+    MVMCallsite *cs = arg_info.callsite;
+    MVMRegister none = { .o = NULL };
+    MVMuint64 key = make_key(tc, cs,
+            cs->flag_count >= 1 ? arg_info.source[arg_info.map[0]] : none,
+            cs->flag_count >= 2 ? arg_info.source[arg_info.map[1]] : none);
+    size_t slot = first_slot(disp, cs, key);
+    MVMuint32 i;
+    for (i = 0; i < MVM_DISP_MEGAMORPHIC_PROBE; i++) {
+        MVMDispMegamorphicEntry *entry = (MVMDispMegamorphicEntry *)MVM_load(&(entries[slot]));
+        if (!entry)
+            return 0;
+        if (entry->key == key && entry->disp == disp && entry->cs == cs) {
+            MVMDispProgram *dp = entry->dp;
+            entry->used = 1;
+            MVMCallStackDispatchRun *record = MVM_callstack_allocate_dispatch_run(tc,
+                    dp->num_temporaries);
+            record->arg_info = arg_info;
+            /* The program isn't one of the site's own, so there's nothing
+             * that spesh could do with a resolution logged against it. */
+            if (MVM_disp_program_run(tc, dp, record, 0, 0, 0))
+                return 1;
+            MVM_callstack_unwind_failed_dispatch_run(tc);
+            return 0;
+        }
+        slot = (slot + 1) & (MVM_DISP_MEGAMORPHIC_CACHE_SIZE - 1);
+    }
+    return 0;
+}
+
+/* Puts an entry that was replaced in the table on the list of those to free
+ * once nothing can be using them. */
+static void evict(MVMThreadContext *tc, MVMDispMegamorphicEntry *entry) {
+    MVMDispMegamorphicCache *cache = &(tc->instance->disp_megamorphic);
+    MVMDispMegamorphicEntry *orig;
+    entry->evicted_gc = MVM_load(&(tc->instance->gc_seq_number));
+    entry->dp->megamorphic_evicted = 1;
+    do {
+        orig = (MVMDispMegamorphicEntry *)MVM_load(&(cache->evicted));
+        entry->next_evicted = orig;
+    } while (!MVM_trycas(&(cache->evicted), orig, entry));
+}
+
+/* Offers a dispatch program recorded at a megamorphic site to the cache. If
+ * it is accepted, the cache takes ownership of it and a true value is
+ * returned. */
+MVMuint32 MVM_disp_megamorphic_add(MVMThreadContext *tc, MVMDispDefinition *disp,
+        MVMCapture *capture, MVMDispProgram *dp) {
+    MVMDispMegamorphicEntry **entries = tc->instance->disp_megamorphic.entries;
+    MVMCallsite *cs = capture->body.callsite;
+    MVMRegister none = { .o = NULL };
+
+    /* We compare callsites by identity, which is only meaningful if they are
+     * interned; programs that can be resumed need their recording site. */
+    if (!cs->is_interned || dp->num_resumptions > 0)
+        return 0;
+
+    MVMuint64 key = make_key(tc, cs,
+            cs->flag_count >= 1 ? capture->body.args[0] : none,
+            cs->flag_count >= 2 ? capture->body.args[1] : none);
+    size_t slot = first_slot(disp, cs, key);
+    MVMDispMegamorphicEntry *new_entry = MVM_malloc(sizeof(MVMDispMegamorphicEntry));
+    new_entry->disp = disp;
+    new_entry->cs = cs;
+    new_entry->key = key;
+    new_entry->dp = dp;
+    new_entry->used = 0;
+    new_entry->evicted_gc = 0;
+    new_entry->next_evicted = NULL;
+
+    /* Take the first free slot, noting the first entry that has not been
+     * used since it was last passed over, and giving the rest a second
+     * chance. */
+    size_t victim_slot = slot;
+    MVMDispMegamorphicEntry *victim = NULL;
+    MVMuint32 i;
+    for (i = 0; i < MVM_DISP_MEGAMORPHIC_PROBE; i++) {
+        MVMDispMegamorphicEntry *entry = (MVMDispMegamorphicEntry *)MVM_load(&(entries[slot]));
+        if (!entry) {
+            if (MVM_trycas(&(entries[slot]), NULL, new_entry))
+                return 1;
+        }
+        else if (!victim) {
+            if (!entry->used) {
+                victim_slot = slot;
+                victim = entry;
+            }
+            else {
+                entry->used = 0;
+            }
+        }
+        slot = (slot + 1) & (MVM_DISP_MEGAMORPHIC_CACHE_SIZE - 1);
+    }
+
+    /* All in use; replace the victim, or failing that, the entry in the
+     * first slot. Losing a race with another thread doing the same is fine,
+     * as it means the slot got a fresh entry anyway. */
+    if (!victim)
+        victim = (MVMDispMegamorphicEntry *)MVM_load(&(entries[victim_slot]));
+    if (victim && MVM_trycas(&(entries[victim_slot]), victim, new_entry)) {
+        evict(tc, victim);
+        return 1;
+    }
+    MVM_free(new_entry);
+    return 0;
+}
+
+static void destroy_entry(MVMThreadContext *tc, MVMDispMegamorphicEntry *entry) {
+    MVM_disp_program_destroy(tc, entry->dp);
+    MVM_free(entry);
+}
+
+/* Frees evicted entries that nothing can be using any more. This happens
+ * while marking instance roots, when no thread is running a dispatch program
+ * or adding to the list. An entry is freed once the GC run before this one
+ * started after it was evicted and found no dispatch run record using it. */
+static void free_unused_evicted(MVMThreadContext *tc) {
+    MVMDispMegamorphicEntry **prev = &(tc->instance->disp_megamorphic.evicted);
+    MVMuint64 last_gc = (MVMuint64)MVM_load(&(tc->instance->gc_seq_number)) - 1;
+    while (*prev) {
+        MVMDispMegamorphicEntry *entry = *prev;
+        if (entry->evicted_gc < last_gc
+                && (MVMuint64)MVM_load(&(entry->dp->megamorphic_seen_gc)) < last_gc) {
+            *prev = entry->next_evicted;
+            destroy_entry(tc, entry);
+        }
+        else {
+            prev = &(entry->next_evicted);
+        }
+    }
+}
+
+/* Marks the programs in the table. Evicted ones aren't marked: they are not
+ * run again, and a run record only needs the program to mark its own
+ * temporaries. */
+void MVM_disp_megamorphic_mark(MVMThreadContext *tc, MVMGCWorklist *worklist,
+        MVMHeapSnapshotState *snapshot) {
+    MVMDispMegamorphicEntry **entries = tc->instance->disp_megamorphic.entries;
+    MVMuint32 i;
+    for (i = 0; i < MVM_DISP_MEGAMORPHIC_CACHE_SIZE; i++)
+        if (entries[i])
+            MVM_disp_program_mark(tc, entries[i]->dp, worklist, snapshot);
+    if (worklist)
+        free_unused_evicted(tc);
+}
+
+void MVM_disp_megamorphic_destroy(MVMThreadContext *tc) {
+    MVMDispMegamorphicEntry **entries = tc->instance->disp_megamorphic.entries;
+    MVMuint32 i;
+    MVMDispMegamorphicEntry *evicted = tc->instance->disp_megamorphic.evicted;
+    for (i = 0; i < MVM_DISP_MEGAMORPHIC_CACHE_SIZE; i++)
+        if (entries[i])
+            destroy_entry(tc, entries[i]);
+    MVM_free(entries);
+    tc->instance->disp_megamorphic.entries = NULL;
+    while (evicted) {
+        MVMDispMegamorphicEntry *next = evicted->next_evicted;
+        destroy_entry(tc, evicted);
+        evicted = next;
+    }
+    tc->instance->disp_megamorphic.evicted = NULL;
+}
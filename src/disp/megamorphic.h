@@ -0,0 +1,62 @@
+/* The megamorphic dispatch cache. Once an inline cache has accumulated
+ * MVM_INLINE_CACHE_MAX_POLY dispatch programs, it stops taking new ones, and
+ * without anything else every miss at that site means running the dispatch
+ * callback again. Call sites that are megamorphic tend to be so in the same
+ * way (think of generic serialization code calling the same methods on a wide
+ * range of types), so rather than leaving each site to resolve things alone,
+ * programs recorded at megamorphic sites are shared through this
+ * instance-wide cache.
+ *
+ * Entries are keyed on the dispatcher, the (interned) callsite, the type of
+ * the first argument and, if the second argument is a string, its hash code
+ * (typically a method name). The key only selects a candidate; running the
+ * dispatch program checks all of its guards as usual, so a collision costs a
+ * failed guard and nothing more.
+ *
+ * The table is fixed size and slots are updated by CAS, so lookups need no
+ * locks. When all the slots a key may go in are taken, one is given to the
+ * new entry, preferring one that has not been used since it was last passed
+ * over for eviction (a second chance). The evicted entry is no longer a GC
+ * root, but it can't be freed yet: another thread may be running its program
+ * right now, and a dispatch run record on some callstack may point at the
+ * program for as long as the frame it dispatched to lives. Evicted entries
+ * are therefore kept on a list until a GC run that started after they were
+ * evicted finds no dispatch run record using them, and freed at the GC run
+ * after that. A program does not reach a safepoint between being looked up
+ * and its run record pointing at it, so once a GC run has started, no new
+ * records using an evicted program can appear. */
+
+#define MVM_DISP_MEGAMORPHIC_CACHE_SIZE 4096
+#define MVM_DISP_MEGAMORPHIC_PROBE      4
+
+struct MVMDispMegamorphicEntry {
+    MVMDispDefinition *disp;
+    MVMCallsite *cs;
+    MVMuint64 key;
+    MVMDispProgram *dp;
+
+    /* Set when the entry is used, and cleared when it is passed over for
+     * eviction. */
+    MVMuint8 used;
+
+    /* Once evicted, the GC sequence number at the time, and the next entry
+     * in the list of evicted ones. */
+    AO_t evicted_gc;
+    MVMDispMegamorphicEntry *next_evicted;
+};
+
+struct MVMDispMegamorphicCache {
+    MVMDispMegamorphicEntry **entries;
+
+    /* Entries that have been evicted but not yet freed. */
+    MVMDispMegamorphicEntry *evicted;
+};
+
+void MVM_disp_megamorphic_init(MVMThreadContext *tc);
+MVMint64 MVM_disp_megamorphic_run(MVMThreadContext *tc, MVMDispDefinition *disp,
+        MVMArgs arg_info);
+MVMuint32 MVM_disp_megamorphic_add(MVMThreadContext *tc, MVMDispDefinition *disp,
+        MVMCapture *capture, MVMDispProgram *dp);
+void MVM_disp_megamorphic_mark(MVMThreadContext *tc, MVMGCWorklist *worklist,
+        MVMHeapSnapshotState *snapshot);
+void MVM_disp_megamorphic_destroy(MVMThreadContext *tc);
@@ -574,6 +574,9 @@ void MVM_disp_program_run_dispatch(MVMThreadContext *tc, MVMDispDefinition *disp
      * after it is freed). */
     MVMuint32 inline_cache_size = calculate_inline_cache_size(tc, ic_entry);
 
+    if (tc->instance->disp_stats)
+        MVM_disp_stats_recording(tc, update_sf, ic_entry_ptr);
+
     /* Form an argument capture. */
     MVMObject *capture;
     MVMROOT(tc, update_sf) {
@@ -2874,6 +2877,8 @@ static void process_recording(MVMThreadContext *tc, MVMCallStackDispatchRecord *
     /* Allocate the dispatch program and space for any new resumptions that
      * it has set up for the future. */
     MVMDispProgram *dp = MVM_malloc(sizeof(MVMDispProgram));
+    dp->megamorphic_evicted = 0;
+    dp->megamorphic_seen_gc = 0;
     dp->num_resumptions = MVM_VECTOR_ELEMS(record->rec.resume_inits);
     dp->resumptions = dp->num_resumptions
             ? MVM_calloc(dp->num_resumptions, sizeof(MVMDispProgramResumption))
@@ -3073,6 +3078,13 @@ static void process_recording(MVMThreadContext *tc, MVMCallStackDispatchRecord *
             ((MVMCapture *)record->rec.initial_capture.capture)->body.callsite,
             dp);
 
+    /* If the site is megamorphic, the program can't go in its inline cache,
+     * but other megamorphic sites may well have use for it. */
+    if (!installed && !record->rec.do_not_install &&
+            MVM_disp_inline_cache_is_megamorphic(tc, record->ic_entry_ptr, record->ic_entry))
+        installed = MVM_disp_megamorphic_add(tc, record->initial_disp,
+            (MVMCapture *)record->rec.initial_capture.capture, dp);
+
     /* We may need to keep the dispatch program around for the sake of any
      * resumptions. */
     if (dp->num_resumptions > 0) {
@@ -3102,6 +3114,8 @@ MVMuint32 MVM_disp_program_record_end(MVMThreadContext *tc, MVMCallStackDispatch
                 MVM_exception_throw_adhoc(tc, "Dispatch callback failed to delegate to a dispatcher");
             return 0;
         case MVM_DISP_OUTCOME_RESUME: {
+            if (tc->instance->disp_stats)
+                MVM_disp_stats_resumption(tc, record->update_sf, record->ic_entry_ptr);
             MVMDispProgramRecordingResumption *rec_resumption = get_current_resumption(tc, record);
             run_resume(tc, record, rec_resumption->resumption->disp,
                     record->outcome.resume_capture);
@@ -3727,6 +3741,9 @@ static void mark_resumption_temps(MVMThreadContext *tc, MVMDispProgram *dp,
 void MVM_disp_program_mark_run_temps(MVMThreadContext *tc, MVMDispProgram *dp,
         MVMCallsite *cs, MVMRegister *temps, MVMGCWorklist *worklist,
         MVMHeapSnapshotState *snapshot) {
+    /* Tell the megamorphic cache that a program it evicted is still in use. */
+    if (dp->megamorphic_evicted)
+        MVM_store(&(dp->megamorphic_seen_gc), MVM_load(&(tc->instance->gc_seq_number)));
     if (dp->num_temporaries != dp->first_args_temporary) {
         /* Some of the temporaries form the result argument capture. */
         for (MVMuint32 i = 0; i < cs->flag_count; i++) {
@@ -344,6 +344,12 @@ struct MVMDispProgram {
     /* Resumptions, if any, ordered innermost first. */
     MVMDispProgramResumption *resumptions;
     MVMuint32 num_resumptions;
+
+    /* Set once the megamorphic cache has evicted the program. From then on
+     * megamorphic_seen_gc is the sequence number of the latest GC run that
+     * found a dispatch run record using it (see megamorphic.h). */
+    MVMuint32 megamorphic_evicted;
+    AO_t megamorphic_seen_gc;
 };
 
 /* Various kinds of constant we use during a dispatch program, to let us keep
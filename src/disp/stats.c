@@ -0,0 +1,184 @@
+#include "moar.h"
+
+MVMDispStats * MVM_disp_stats_create(MVMInstance *instance, FILE *fh) {
+    MVMDispStats *stats = MVM_calloc(1, sizeof(MVMDispStats));
+    stats->fh = fh;
+    uv_mutex_init(&stats->mutex);
+    MVM_VECTOR_INIT(stats->sites, 256);
+    return stats;
+}
+
+/* Describes a site. We only use strings that are already decoded, so that we
+ * can't end up allocating (and maybe GCing) while holding the lock. */
+static char * describe_site(MVMThreadContext *tc, MVMStaticFrame *sf, MVMuint32 offset) {
+    MVMCompUnit *cu = sf->body.cu;
+    MVMBytecodeAnnotation *annot = MVM_bytecode_resolve_annotation(tc, &(sf->body), offset);
+    MVMString *file = annot && annot->filename_string_heap_index < cu->body.num_strings
+        ? cu->body.strings[annot->filename_string_heap_index]
+        : NULL;
+    char *file_c = file ? MVM_string_utf8_encode_C_string(tc, file) : NULL;
+    char *name_c = sf->body.name ? MVM_string_utf8_encode_C_string(tc, sf->body.name) : NULL;
+    char *cuuid_c = sf->body.cuuid ? MVM_string_utf8_encode_C_string(tc, sf->body.cuuid) : NULL;
+    char *result = MVM_malloc(1024);
+    snprintf(result, 1024, "%s (%s) %s:%u +%u",
+        name_c && name_c[0] ? name_c : "<anonymous frame>",
+        cuuid_c ? cuuid_c : "?",
+        file_c ? file_c : "<unknown>",
+        annot ? annot->line_number : 0,
+        offset);
+    MVM_free(file_c);
+    MVM_free(name_c);
+    MVM_free(cuuid_c);
+    MVM_free(annot);
+    return result;
+}
+
+/* Finds, or creates, the record for a site. Must hold the lock. */
+static MVMDispStatsSite * get_site(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr) {
+    MVMDispStats *stats = tc->instance->disp_stats;
+    MVMDispInlineCache *cache = &(sf->body.inline_cache);
+    MVMuint32 slot;
+    if (!cache->entries || entry_ptr < cache->entries ||
+            entry_ptr >= cache->entries + cache->num_entries)
+        return NULL;
+    slot = entry_ptr - cache->entries;
+    if (!cache->stats)
+        cache->stats = MVM_calloc(cache->num_entries, sizeof(MVMDispStatsSite *));
+    if (!cache->stats[slot]) {
+        MVMDispStatsSite *site = MVM_calloc(1, sizeof(MVMDispStatsSite));
+        site->description = describe_site(tc, sf, slot << cache->bit_shift);
+        cache->stats[slot] = site;
+        MVM_VECTOR_PUSH(stats->sites, site);
+    }
+    return cache->stats[slot];
+}
+
+void MVM_disp_stats_run(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr, MVMuint64 ns, MVMint64 outcome) {
+    MVMDispStats *stats = tc->instance->disp_stats;
+    MVMDispStatsSite *site;
+    uv_mutex_lock(&stats->mutex);
+    if ((site = get_site(tc, sf, entry_ptr))) {
+        site->runs++;
+        if (!outcome)
+            site->rejections++;
+        site->run_ns += ns;
+    }
+    uv_mutex_unlock(&stats->mutex);
+}
+
+void MVM_disp_stats_recording(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr) {
+    MVMDispStats *stats = tc->instance->disp_stats;
+    MVMDispStatsSite *site;
+    uv_mutex_lock(&stats->mutex);
+    if ((site = get_site(tc, sf, entry_ptr)))
+        site->recordings++;
+    uv_mutex_unlock(&stats->mutex);
+}
+
+void MVM_disp_stats_resumption(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr) {
+    MVMDispStats *stats = tc->instance->disp_stats;
+    MVMDispStatsSite *site;
+    uv_mutex_lock(&stats->mutex);
+    if ((site = get_site(tc, sf, entry_ptr)))
+        site->resumptions++;
+    uv_mutex_unlock(&stats->mutex);
+}
+
+/* Called after an attempt to add a dispatch program to the inline cache
+ * entry; we look at what the entry now is. */
+void MVM_disp_stats_transition(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr, MVMuint32 installed) {
+    MVMDispStats *stats = tc->instance->disp_stats;
+    MVMDispInlineCacheEntry *entry = *entry_ptr;
+    MVMDispStatsSite *site;
+    MVMuint32 num_dps = 0;
+    uv_mutex_lock(&stats->mutex);
+    if ((site = get_site(tc, sf, entry_ptr))) {
+        switch (MVM_disp_inline_cache_try_get_kind(tc, entry)) {
+            case MVM_INLINE_CACHE_KIND_MONOMORPHIC_DISPATCH:
+            case MVM_INLINE_CACHE_KIND_MONOMORPHIC_DISPATCH_FLATTENING:
+                if (installed)
+                    site->to_monomorphic++;
+                num_dps = 1;
+                break;
+            case MVM_INLINE_CACHE_KIND_POLYMORPHIC_DISPATCH:
+                if (installed)
+                    site->to_polymorphic++;
+                num_dps = ((MVMDispInlineCacheEntryPolymorphicDispatch *)entry)->num_dps;
+                break;
+            case MVM_INLINE_CACHE_KIND_POLYMORPHIC_DISPATCH_FLATTENING:
+                if (installed)
+                    site->to_polymorphic++;
+                num_dps = ((MVMDispInlineCacheEntryPolymorphicDispatchFlattening *)entry)->num_dps;
+                break;
+        }
+        if (!installed && MVM_disp_inline_cache_is_megamorphic(tc, entry_ptr, entry))
+            site->megamorphic_misses++;
+        if (num_dps > site->max_dps)
+            site->max_dps = num_dps;
+    }
+    uv_mutex_unlock(&stats->mutex);
+}
+
+static int compare_sites(const void *a, const void *b) {
+    const MVMDispStatsSite *x = *(const MVMDispStatsSite **)a;
+    const MVMDispStatsSite *y = *(const MVMDispStatsSite **)b;
+    if (x->run_ns != y->run_ns)
+        return x->run_ns < y->run_ns ? 1 : -1;
+    if (x->runs != y->runs)
+        return x->runs < y->runs ? 1 : -1;
+    return 0;
+}
+
+/* Writes the report, most expensive sites first. */
+void MVM_disp_stats_report(MVMInstance *instance) {
+    MVMDispStats *stats = instance->disp_stats;
+    FILE *fh;
+    MVMuint64 total_ns = 0;
+    size_t i, num_sites;
+    if (!stats)
+        return;
+    fh = stats->fh;
+    uv_mutex_lock(&stats->mutex);
+    num_sites = MVM_VECTOR_ELEMS(stats->sites);
+    qsort(stats->sites, num_sites, sizeof(MVMDispStatsSite *), compare_sites);
+    for (i = 0; i < num_sites; i++)
+        total_ns += stats->sites[i]->run_ns;
+    fprintf(fh, "Dispatch sites: %"PRIu64", time in dispatch programs: %.3fms\n\n",
+        (MVMuint64)num_sites, total_ns / 1e6);
+    fprintf(fh, "%10s %6s %10s %10s %8s %7s %5s %5s %5s %5s  %s\n",
+        "time (ms)", "%", "runs", "rejected", "recorded", "resumed",
+        "dps", "mono", "poly", "mega", "site");
+    for (i = 0; i < num_sites; i++) {
+        MVMDispStatsSite *site = stats->sites[i];
+        fprintf(fh, "%10.3f %6.2f %10"PRIu64" %10"PRIu64" %8"PRIu64" %7"PRIu64" %5u %5u %5u %5u  %s\n",
+            site->run_ns / 1e6,
+            total_ns ? 100.0 * site->run_ns / total_ns : 0.0,
+            site->runs, site->rejections, site->recordings, site->resumptions,
+            site->max_dps, site->to_monomorphic, site->to_polymorphic,
+            site->megamorphic_misses, site->description);
+    }
+    fflush(fh);
+    uv_mutex_unlock(&stats->mutex);
+}
+
+void MVM_disp_stats_destroy(MVMInstance *instance) {
+    MVMDispStats *stats = instance->disp_stats;
+    size_t i;
+    if (!stats)
+        return;
+    for (i = 0; i < MVM_VECTOR_ELEMS(stats->sites); i++) {
+        MVM_free(stats->sites[i]->description);
+        MVM_free(stats->sites[i]);
+    }
+    MVM_VECTOR_DESTROY(stats->sites);
+    if (stats->fh != stderr)
+        fclose(stats->fh);
+    uv_mutex_destroy(&stats->mutex);
+    MVM_free(stats);
+    instance->disp_stats = NULL;
+}
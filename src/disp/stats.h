@@ -0,0 +1,61 @@
+/* Per call site dispatch statistics, enabled with MVM_DISP_STATS_LOG. These
+ * are meant for finding the sites that make dispatch slow: how morphic they
+ * get, how often their dispatch programs are run and rejected, how often we
+ * have to go back to the dispatcher to record a new program, and how much
+ * time is spent in running dispatch programs there. A report, sorted by that
+ * time, is written out at exit.
+ *
+ * Sites are identified by their slot in a static frame's inline cache. The
+ * site records themselves live in an instance-wide list, so that they outlive
+ * static frames that get collected along the way. All updates are done under
+ * a single lock; this is a diagnostic tool, not something to leave on. */
+
+struct MVMDispStatsSite {
+    /* Description of the site (frame name, file, line, bytecode offset). */
+    char *description;
+
+    /* Dispatch program runs, and how many of those were rejected. */
+    MVMuint64 runs;
+    MVMuint64 rejections;
+
+    /* Total time spent in running dispatch programs, in nanoseconds. */
+    MVMuint64 run_ns;
+
+    /* Times we ran the dispatcher to record a new program, and how many of
+     * those ended up resuming a dispatch. */
+    MVMuint64 recordings;
+    MVMuint64 resumptions;
+
+    /* Transitions of the inline cache entry to monomorphic and polymorphic
+     * states, and how many programs could not be installed because the
+     * site is megamorphic. */
+    MVMuint32 to_monomorphic;
+    MVMuint32 to_polymorphic;
+    MVMuint32 megamorphic_misses;
+
+    /* Largest number of dispatch programs seen at the site. */
+    MVMuint32 max_dps;
+};
+
+struct MVMDispStats {
+    /* Where to write the report. */
+    FILE *fh;
+
+    /* Lock protecting everything here and the per-frame site arrays. */
+    uv_mutex_t mutex;
+
+    /* All of the sites we have seen. */
+    MVM_VECTOR_DECL(MVMDispStatsSite *, sites);
+};
+
+MVMDispStats * MVM_disp_stats_create(MVMInstance *instance, FILE *fh);
+void MVM_disp_stats_run(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr, MVMuint64 ns, MVMint64 outcome);
+void MVM_disp_stats_recording(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr);
+void MVM_disp_stats_resumption(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr);
+void MVM_disp_stats_transition(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMDispInlineCacheEntry **entry_ptr, MVMuint32 installed);
+void MVM_disp_stats_report(MVMInstance *instance);
+void MVM_disp_stats_destroy(MVMInstance *instance);
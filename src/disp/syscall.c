@@ -1647,6 +1647,155 @@ static MVMDispSysCall is_debugserver_running = {
     .expected_concrete = { 0 },
 };
 
+/* strbuilder-new */
+static void strbuilder_new_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *builder = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTStringBuilder);
+    MVM_args_set_result_obj(tc, builder, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall strbuilder_new = {
+    .c_name = "strbuilder-new",
+    .implementation = strbuilder_new_impl,
+    .min_args = 0,
+    .max_args = 0,
+    .expected_kinds = { 0 },
+    .expected_reprs = { 0 },
+    .expected_concrete = { 0 },
+};
+
+/* strbuilder-append-str */
+static void strbuilder_append_str_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *builder = get_obj_arg(arg_info, 0);
+    MVMROOT(tc, builder) {
+        MVM_string_builder_append_str(tc, builder, get_str_arg(arg_info, 1));
+    }
+    MVM_args_set_result_obj(tc, builder, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall strbuilder_append_str = {
+    .c_name = "strbuilder-append-str",
+    .implementation = strbuilder_append_str_impl,
+    .min_args = 2,
+    .max_args = 2,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ, MVM_CALLSITE_ARG_STR },
+    .expected_reprs = { MVM_REPR_ID_MVMStringBuilder, 0 },
+    .expected_concrete = { 1, 1 },
+};
+
+/* strbuilder-append-codepoint */
+static void strbuilder_append_codepoint_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *builder = get_obj_arg(arg_info, 0);
+    MVMROOT(tc, builder) {
+        MVM_string_builder_append_codepoint(tc, builder, get_int_arg(arg_info, 1));
+    }
+    MVM_args_set_result_obj(tc, builder, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall strbuilder_append_codepoint = {
+    .c_name = "strbuilder-append-codepoint",
+    .implementation = strbuilder_append_codepoint_impl,
+    .min_args = 2,
+    .max_args = 2,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ, MVM_CALLSITE_ARG_INT },
+    .expected_reprs = { MVM_REPR_ID_MVMStringBuilder, 0 },
+    .expected_concrete = { 1, 1 },
+};
+
+/* strbuilder-append-int */
+static void strbuilder_append_int_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *builder = get_obj_arg(arg_info, 0);
+    MVMROOT(tc, builder) {
+        MVM_string_builder_append_int(tc, builder, get_int_arg(arg_info, 1));
+    }
+    MVM_args_set_result_obj(tc, builder, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall strbuilder_append_int = {
+    .c_name = "strbuilder-append-int",
+    .implementation = strbuilder_append_int_impl,
+    .min_args = 2,
+    .max_args = 2,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ, MVM_CALLSITE_ARG_INT },
+    .expected_reprs = { MVM_REPR_ID_MVMStringBuilder, 0 },
+    .expected_concrete = { 1, 1 },
+};
+
+/* strbuilder-finish */
+static void strbuilder_finish_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMString *result = MVM_string_builder_finish(tc, get_obj_arg(arg_info, 0));
+    MVM_args_set_result_str(tc, result, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall strbuilder_finish = {
+    .c_name = "strbuilder-finish",
+    .implementation = strbuilder_finish_impl,
+    .min_args = 1,
+    .max_args = 1,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ },
+    .expected_reprs = { MVM_REPR_ID_MVMStringBuilder },
+    .expected_concrete = { 1 },
+};
+
+/* inthash-delete-key */
+static void inthash_delete_key_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMint64 deleted = MVM_IntHash_delete_key(tc, get_obj_arg(arg_info, 0),
+        get_int_arg(arg_info, 1));
+    MVM_args_set_result_int(tc, deleted, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall inthash_delete_key = {
+    .c_name = "inthash-delete-key",
+    .implementation = inthash_delete_key_impl,
+    .min_args = 2,
+    .max_args = 2,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ, MVM_CALLSITE_ARG_INT },
+    .expected_reprs = { MVM_REPR_ID_IntHash, 0 },
+    .expected_concrete = { 1, 1 },
+};
+
+/* inthash-keys */
+static void inthash_keys_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *result = MVM_IntHash_keys(tc, get_obj_arg(arg_info, 0));
+    MVM_args_set_result_obj(tc, result, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall inthash_keys = {
+    .c_name = "inthash-keys",
+    .implementation = inthash_keys_impl,
+    .min_args = 1,
+    .max_args = 1,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ },
+    .expected_reprs = { MVM_REPR_ID_IntHash },
+    .expected_concrete = { 1 },
+};
+
+/* unicode-collation-key */
+static void unicode_collation_key_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *result = MVM_unicode_string_collation_key(tc, get_str_arg(arg_info, 0),
+        get_int_arg(arg_info, 1), get_int_arg(arg_info, 2), get_int_arg(arg_info, 3),
+        get_obj_arg(arg_info, 4));
+    MVM_args_set_result_obj(tc, result, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall unicode_collation_key = {
+    .c_name = "unicode-collation-key",
+    .implementation = unicode_collation_key_impl,
+    .min_args = 5,
+    .max_args = 5,
+    .expected_kinds = { MVM_CALLSITE_ARG_STR, MVM_CALLSITE_ARG_INT, MVM_CALLSITE_ARG_INT, MVM_CALLSITE_ARG_INT, MVM_CALLSITE_ARG_OBJ },
+    .expected_reprs = { 0, 0, 0, 0, MVM_REPR_ID_VMArray },
+    .expected_concrete = { 1, 1, 1, 1, 1 },
+};
+
+/* unicode-collation-sort */
+static void unicode_collation_sort_impl(MVMThreadContext *tc, MVMArgs arg_info) {
+    MVMObject *array = get_obj_arg(arg_info, 0);
+    MVM_unicode_string_collation_sort(tc, array, get_int_arg(arg_info, 1),
+        get_int_arg(arg_info, 2), get_int_arg(arg_info, 3));
+    MVM_args_set_result_obj(tc, array, MVM_RETURN_CURRENT_FRAME);
+}
+static MVMDispSysCall unicode_collation_sort = {
+    .c_name = "unicode-collation-sort",
+    .implementation = unicode_collation_sort_impl,
+    .min_args = 4,
+    .max_args = 4,
+    .expected_kinds = { MVM_CALLSITE_ARG_OBJ, MVM_CALLSITE_ARG_INT, MVM_CALLSITE_ARG_INT, MVM_CALLSITE_ARG_INT },
+    .expected_reprs = { MVM_REPR_ID_VMArray, 0, 0, 0 },
+    .expected_concrete = { 1, 1, 1, 1 },
+};
+
 /* Add all of the syscalls into the hash. */
 MVM_STATIC_INLINE void add_to_hash(MVMThreadContext *tc, MVMDispSysCall *syscall) {
     MVMString *name = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, syscall->c_name);
@@ -1749,6 +1898,15 @@ void MVM_disp_syscall_setup(MVMThreadContext *tc) {
     add_to_hash(tc, &telemetry_interval_stop);
     add_to_hash(tc, &telemetry_interval_annotate);
     add_to_hash(tc, &is_debugserver_running);
+    add_to_hash(tc, &strbuilder_new);
+    add_to_hash(tc, &strbuilder_append_str);
+    add_to_hash(tc, &strbuilder_append_codepoint);
+    add_to_hash(tc, &strbuilder_append_int);
+    add_to_hash(tc, &strbuilder_finish);
+    add_to_hash(tc, &inthash_delete_key);
+    add_to_hash(tc, &inthash_keys);
+    add_to_hash(tc, &unicode_collation_key);
+    add_to_hash(tc, &unicode_collation_sort);
     MVM_gc_allocate_gen2_default_clear(tc);
 }
 
@@ -144,6 +144,7 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
         MVM_disp_registry_mark(tc, worklist);
     else
         MVM_disp_registry_describe(tc, snapshot);
+    MVM_disp_megamorphic_mark(tc, worklist, snapshot);
 
     MVM_debugserver_mark_handles(tc, worklist, snapshot);
 }
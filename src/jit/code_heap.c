@@ -0,0 +1,190 @@
+#include "moar.h"
+#include "platform/mmap.h"
+
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMInstance *instance) {
+    MVMJitCodeHeap *heap = MVM_calloc(1, sizeof(MVMJitCodeHeap));
+    int init_stat;
+    if ((init_stat = uv_mutex_init(&heap->mutex)) < 0)
+        MVM_panic(1, "Could not initialize JIT code heap mutex: %s", uv_strerror(init_stat));
+    return heap;
+}
+
+static size_t align_size(size_t size) {
+    return (size + MVM_JIT_CODE_HEAP_ALIGN - 1) & ~((size_t)MVM_JIT_CODE_HEAP_ALIGN - 1);
+}
+
+static MVMJitCodeHeapRegion * new_region(MVMJitCodeHeap *heap, size_t min_size) {
+    MVMJitCodeHeapRegion *region;
+    /* Oversized code gets a region of its own, rounded up to whole regions
+     * (which are a multiple of any page size). */
+    size_t size = (min_size + MVM_JIT_CODE_HEAP_REGION_SIZE - 1)
+        & ~((size_t)MVM_JIT_CODE_HEAP_REGION_SIZE - 1);
+    void *writable;
+    void *exec = MVM_platform_alloc_dual_pages(size, &writable);
+    if (!exec) {
+        heap->unavailable = 1;
+        return NULL;
+    }
+    region = MVM_calloc(1, sizeof(MVMJitCodeHeapRegion));
+    region->exec  = exec;
+    region->write = writable;
+    region->size  = size;
+    region->next  = heap->regions;
+    heap->regions = region;
+    return region;
+}
+
+/* First fit from the free list, then from the untouched tail. */
+static MVMint64 region_alloc(MVMJitCodeHeapRegion *region, size_t size) {
+    MVMJitCodeHeapFree **prev = &region->free_list;
+    MVMJitCodeHeapFree *block;
+    size_t offset;
+    while ((block = *prev)) {
+        if (block->size >= size) {
+            offset = block->offset;
+            if (block->size == size) {
+                *prev = block->next;
+                MVM_free(block);
+            }
+            else {
+                block->offset += size;
+                block->size   -= size;
+            }
+            region->live += size;
+            return offset;
+        }
+        prev = &block->next;
+    }
+    if (region->size - region->used < size)
+        return -1;
+    offset = region->used;
+    region->used += size;
+    region->live += size;
+    return offset;
+}
+
+static void region_free(MVMJitCodeHeapRegion *region, size_t offset, size_t size) {
+    MVMJitCodeHeapFree **link = &region->free_list, **last_link = NULL;
+    MVMJitCodeHeapFree *last, *next, *block;
+
+    region->live -= size;
+    if (region->live == 0) {
+        /* Nothing left alive, so the whole region can be reused. */
+        while ((block = region->free_list)) {
+            region->free_list = block->next;
+            MVM_free(block);
+        }
+        region->used = 0;
+        return;
+    }
+
+    /* Find the neighbours in the (sorted) free list. */
+    while (*link && (*link)->offset < offset) {
+        last_link = link;
+        link = &(*link)->next;
+    }
+    last = last_link ? *last_link : NULL;
+    next = *link;
+
+    if (offset + size == region->used) {
+        /* Give it back to the untouched tail, along with the free block just
+         * before it if that now ends at the tail too. */
+        region->used = offset;
+        if (last && last->offset + last->size == region->used) {
+            region->used = last->offset;
+            *last_link = NULL;
+            MVM_free(last);
+        }
+        return;
+    }
+
+    /* Merge with the following block if adjacent, otherwise insert. */
+    if (next && offset + size == next->offset) {
+        next->offset = offset;
+        next->size  += size;
+        block = next;
+    }
+    else {
+        block = MVM_malloc(sizeof(MVMJitCodeHeapFree));
+        block->offset = offset;
+        block->size   = size;
+        block->next   = next;
+        *link = block;
+    }
+
+    /* And with the preceding block, if adjacent. */
+    if (last && last->offset + last->size == block->offset) {
+        last->size += block->size;
+        last->next  = block->next;
+        MVM_free(block);
+    }
+}
+
+/* Allocates space for size bytes of code. Returns the address the code will
+ * run at, and sets writable to the address to write it to; returns NULL if
+ * the heap is not available on this platform. */
+void * MVM_jit_code_heap_alloc(MVMThreadContext *tc, size_t size, void **writable) {
+    MVMJitCodeHeap *heap = tc->instance->jit_code_heap;
+    MVMJitCodeHeapRegion *region;
+    MVMint64 offset = -1;
+    void *result = NULL;
+
+    if (!heap || heap->unavailable)
+        return NULL;
+
+    size = align_size(size);
+    uv_mutex_lock(&heap->mutex);
+    for (region = heap->regions; region; region = region->next) {
+        if ((offset = region_alloc(region, size)) >= 0)
+            break;
+    }
+    if (offset < 0 && (region = new_region(heap, size)))
+        offset = region_alloc(region, size);
+    if (offset >= 0) {
+        result    = region->exec + offset;
+        *writable = region->write + offset;
+    }
+    uv_mutex_unlock(&heap->mutex);
+    return result;
+}
+
+/* Releases code allocated from the heap. Returns false if the code was not
+ * allocated from the heap, in which case the caller must free it itself. */
+MVMint32 MVM_jit_code_heap_free(MVMThreadContext *tc, void *code, size_t size) {
+    MVMJitCodeHeap *heap = tc->instance->jit_code_heap;
+    MVMJitCodeHeapRegion *region;
+    MVMint32 found = 0;
+    if (!heap)
+        return 0;
+    uv_mutex_lock(&heap->mutex);
+    for (region = heap->regions; region; region = region->next) {
+        MVMuint8 *addr = code;
+        if (addr >= region->exec && addr < region->exec + region->size) {
+            region_free(region, addr - region->exec, align_size(size));
+            found = 1;
+            break;
+        }
+    }
+    uv_mutex_unlock(&heap->mutex);
+    return found;
+}
+
+void MVM_jit_code_heap_destroy(MVMInstance *instance) {
+    MVMJitCodeHeap *heap = instance->jit_code_heap;
+    MVMJitCodeHeapRegion *region;
+    if (!heap)
+        return;
+    while ((region = heap->regions)) {
+        MVMJitCodeHeapFree *block;
+        heap->regions = region->next;
+        while ((block = region->free_list)) {
+            region->free_list = block->next;
+            MVM_free(block);
+        }
+        MVM_platform_free_dual_pages(region->exec, region->write, region->size);
+        MVM_free(region);
+    }
+    uv_mutex_destroy(&heap->mutex);
+    MVM_free(heap);
+    instance->jit_code_heap = NULL;
+}
@@ -0,0 +1,57 @@
+/* The JIT code heap hands out executable memory for compiled frames. Rather
+ * than giving each frame its own mapping (which costs at least one page and
+ * a couple of syscalls, and scatters hot code over the address space), it
+ * carves code out of large regions that are mapped twice: once read/execute,
+ * which is where the code runs, and once read/write, which is where we write
+ * it. No page is ever writable and executable in the same view, and we never
+ * need to flip page protections on memory that other threads may be running.
+ *
+ * On platforms where we cannot produce such a dual mapping, allocation fails
+ * and the caller falls back to mapping pages per frame. */
+
+#define MVM_JIT_CODE_HEAP_REGION_SIZE (1024 * 1024)
+
+/* Code is aligned to 16 bytes, as compilers do for function entry points. */
+#define MVM_JIT_CODE_HEAP_ALIGN 16
+
+/* A free range within a region, kept sorted by offset. */
+struct MVMJitCodeHeapFree {
+    size_t offset;
+    size_t size;
+    MVMJitCodeHeapFree *next;
+};
+
+struct MVMJitCodeHeapRegion {
+    /* The two views of the region's memory. */
+    MVMuint8 *exec;
+    MVMuint8 *write;
+    size_t    size;
+
+    /* Everything from here to the end of the region is untouched. */
+    size_t    used;
+
+    /* Bytes currently handed out; once this drops to zero, the whole region
+     * is available for bump allocation again. */
+    size_t    live;
+
+    /* Freed ranges below used. */
+    MVMJitCodeHeapFree *free_list;
+
+    MVMJitCodeHeapRegion *next;
+};
+
+struct MVMJitCodeHeap {
+    /* Code is compiled on the spesh thread but may be freed by any thread. */
+    uv_mutex_t mutex;
+
+    /* Regions, most recently created first; that's where we bump allocate. */
+    MVMJitCodeHeapRegion *regions;
+
+    /* Set once dual mapping has failed, so we stop trying. */
+    MVMuint8 unavailable;
+};
+
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMInstance *instance);
+void * MVM_jit_code_heap_alloc(MVMThreadContext *tc, size_t size, void **writable);
+MVMint32 MVM_jit_code_heap_free(MVMThreadContext *tc, void *code, size_t size);
+void MVM_jit_code_heap_destroy(MVMInstance *instance);
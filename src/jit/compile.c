@@ -141,19 +141,8 @@ MVMJitCode * MVM_jit_compile_graph(MVMThreadContext *tc, MVMJitGraph *jg) {
      * to a staticframe, in which case we just skip this.
      * Sometimes code ends up null here as well, in which
      * case we also skip. */
-    if (tc->instance->jit_perf_map && jg->sg->sf && code) {
-        MVMStaticFrame *sf = jg->sg->sf;
-        char symbol_name[1024];
-        char *file_location = MVM_staticframe_file_location(tc, sf);
-        char *frame_name = MVM_string_utf8_encode_C_string(tc, sf->body.name);
-        snprintf(symbol_name, sizeof(symbol_name) - 1,
-                 "%s(%s)",  frame_name, file_location);
-        fprintf(tc->instance->jit_perf_map, "%lx %lx %s\n",
-                (unsigned long) code->func_ptr, code->size, symbol_name);
-        fflush(tc->instance->jit_perf_map);
-        MVM_free(file_location);
-        MVM_free(frame_name);
-    }
+    if (MVM_jit_perf_record_enabled(tc) && jg->sg->sf && code)
+        MVM_jit_perf_record_code(tc, code);
 #endif
 
     /* Logging for insight */
@@ -167,7 +156,9 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
     MVMJitCode * code;
     MVMuint32 i;
     char * memory;
+    char * writable;
     size_t codesize;
+    MVMint32 from_heap;
 
     MVMint32 dasm_error = 0;
 
@@ -178,15 +169,22 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
         return NULL;
     }
 
-    memory = MVM_platform_alloc_pages(codesize, MVM_PAGE_READ|MVM_PAGE_WRITE);
-    if ((dasm_error = dasm_encode(cl, memory)) != 0) {
+    /* Prefer the code heap, which hands us separate executable and writable
+     * views of the same memory; otherwise map pages just for this code. */
+    memory = MVM_jit_code_heap_alloc(tc, codesize, (void **)&writable);
+    from_heap = memory != NULL;
+    if (!from_heap)
+        memory = writable = MVM_platform_alloc_pages(codesize, MVM_PAGE_READ|MVM_PAGE_WRITE);
+    if ((dasm_error = dasm_encode(cl, writable)) != 0) {
         if (tc->instance->jit_debug_enabled)
             fprintf(stderr, "DynASM could not encode, error: %d\n", dasm_error);
+        if (!from_heap || !MVM_jit_code_heap_free(tc, memory, codesize))
+            MVM_platform_free_pages(memory, codesize);
         return NULL;
     }
 
     /* set memory readable + executable */
-    if (!MVM_platform_set_page_mode(memory, codesize, MVM_PAGE_READ|MVM_PAGE_EXEC)) {
+    if (!from_heap && !MVM_platform_set_page_mode(memory, codesize, MVM_PAGE_READ|MVM_PAGE_EXEC)) {
         if (tc->instance->jit_debug_enabled)
             fprintf(stderr, "JIT: Impossible to mark code read/executable");
         /* our caller allocated the compiler and our caller must clean it up */
@@ -240,8 +238,10 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
         }
         code->labels[i] = memory + offset;
     }
-    /* We only ever use one global label, which is the exit label */
-    code->exit_label = cl->dasm_globals[0];
+    /* We only ever use one global label, which is the exit label. DynASM
+     * resolved it against the buffer it wrote to, so translate it to the
+     * executable view. */
+    code->exit_label = memory + ((char *)cl->dasm_globals[0] - writable);
 
     /* Copy the deopts, inlines, and handlers. Because these use the
      * label index rather than the direct pointer, no fixup is
@@ -275,7 +275,8 @@ void MVM_jit_code_destroy(MVMThreadContext *tc, MVMJitCode *code) {
     if (AO_fetch_and_sub1(&code->ref_cnt) > 1)
         return;
 #endif
-    MVM_platform_free_pages(code->func_ptr, code->size);
+    if (!MVM_jit_code_heap_free(tc, code->func_ptr, code->size))
+        MVM_platform_free_pages(code->func_ptr, code->size);
     MVM_free(code->labels);
     MVM_free(code->deopts);
     MVM_free(code->handlers);
@@ -334,7 +335,7 @@ void MVM_jit_compile_guard(MVMThreadContext *tc, MVMJitCompiler *compiler,
 void MVM_jit_compile_expr_tree(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitGraph *jg, MVMJitExprTree *tree) {
     MVMJitTileList *list;
     MVMJitTile *tile;
-    MVMuint32 i;
+    MVMuint32 i, removed;
 
     /* Log what we are planning to compile */
     if (MVM_jit_debug_enabled(tc))
@@ -349,6 +350,14 @@ void MVM_jit_compile_expr_tree(MVMThreadContext *tc, MVMJitCompiler *compiler, M
     /* Second stage, allocate registers */
     MVM_jit_linear_scan_allocate(tc, compiler, list);
 
+    /* Clean up the moves, loads and stores that leaves behind */
+    removed = MVM_jit_tile_list_peephole(tc, list);
+    if (MVM_jit_debug_enabled(tc)) {
+        MVM_spesh_debug_printf(tc, "JIT: peephole removed %u of %u tiles\n",
+                               removed, list->items_num);
+        MVM_jit_dump_tile_list(tc, list);
+    }
+
     /* Allocate sufficient space for the new internal labels */
     dasm_growpc(compiler, compiler->label_offset);
 
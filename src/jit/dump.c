@@ -2,6 +2,15 @@
 #include "jit/internal.h"
 #include "platform/io.h"
 
+#if linux
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 void MVM_jit_dump_bytecode(MVMThreadContext *tc, MVMJitCode *code) {
     char filename[1024];
     FILE * dump;
@@ -22,6 +31,142 @@ void MVM_jit_dump_bytecode(MVMThreadContext *tc, MVMJitCode *code) {
 }
 
 
+#if linux
+/* The jitdump format understood by perf inject --jit. See
+ * tools/perf/Documentation/jitdump-specification.txt in the linux sources.
+ * All timestamps must come from the same clock as perf record -k mono. */
+#define MVM_JIT_DUMP_MAGIC     0x4A695444
+#define MVM_JIT_DUMP_VERSION   1
+#define MVM_JIT_DUMP_CODE_LOAD 0
+
+struct jitdump_header {
+    MVMuint32 magic;
+    MVMuint32 version;
+    MVMuint32 total_size;
+    MVMuint32 elf_mach;
+    MVMuint32 pad1;
+    MVMuint32 pid;
+    MVMuint64 timestamp;
+    MVMuint64 flags;
+};
+
+struct jitdump_code_load {
+    MVMuint32 id;
+    MVMuint32 total_size;
+    MVMuint64 timestamp;
+    MVMuint32 pid;
+    MVMuint32 tid;
+    MVMuint64 vma;
+    MVMuint64 code_addr;
+    MVMuint64 code_size;
+    MVMuint64 code_index;
+};
+
+static MVMuint64 jitdump_timestamp(void) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return 0;
+    return (MVMuint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void MVM_jit_perf_dump_open(MVMInstance *instance, const char *dir) {
+    char filename[1024];
+    struct jitdump_header header;
+    int fd;
+    void *marker;
+    MVMint64 pid = MVM_proc_getpid(NULL);
+
+    snprintf(filename, sizeof(filename), "%s/jit-%"PRIi64".dump", dir, pid);
+    fd = open(filename, O_CREAT | O_TRUNC | O_RDWR, 0666);
+    if (fd < 0)
+        return;
+
+    /* perf only notices the dump file by way of an executable mapping of it
+     * showing up in the event stream, so we keep one page mapped for as long
+     * as we write to it. */
+    marker = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC,
+                  MAP_PRIVATE, fd, 0);
+    if (marker == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+
+    instance->jit_perf_dump = fdopen(fd, "wb");
+    if (!instance->jit_perf_dump) {
+        munmap(marker, sysconf(_SC_PAGESIZE));
+        close(fd);
+        return;
+    }
+    instance->jit_perf_dump_marker = marker;
+
+    memset(&header, 0, sizeof(header));
+    header.magic      = MVM_JIT_DUMP_MAGIC;
+    header.version    = MVM_JIT_DUMP_VERSION;
+    header.total_size = sizeof(header);
+    header.elf_mach   = EM_X86_64;
+    header.pid        = (MVMuint32)pid;
+    header.timestamp  = jitdump_timestamp();
+    fwrite(&header, sizeof(header), 1, instance->jit_perf_dump);
+    fflush(instance->jit_perf_dump);
+}
+
+void MVM_jit_perf_dump_close(MVMInstance *instance) {
+    if (!instance->jit_perf_dump)
+        return;
+    munmap(instance->jit_perf_dump_marker, sysconf(_SC_PAGESIZE));
+    fclose(instance->jit_perf_dump);
+    instance->jit_perf_dump        = NULL;
+    instance->jit_perf_dump_marker = NULL;
+}
+
+static void perf_dump_code(MVMThreadContext *tc, MVMJitCode *code, const char *symbol_name) {
+    struct jitdump_code_load record;
+    size_t name_size = strlen(symbol_name) + 1;
+    char *buffer;
+
+    record.id         = MVM_JIT_DUMP_CODE_LOAD;
+    record.total_size = sizeof(record) + name_size + code->size;
+    record.timestamp  = jitdump_timestamp();
+    record.pid        = (MVMuint32)MVM_proc_getpid(NULL);
+    record.tid        = (MVMuint32)syscall(SYS_gettid);
+    record.vma        = (MVMuint64)(uintptr_t)code->func_ptr;
+    record.code_addr  = record.vma;
+    record.code_size  = code->size;
+    record.code_index = MVM_incr(&tc->instance->jit_perf_dump_index);
+
+    /* Assemble the whole record first, so that a single fwrite keeps it
+     * contiguous even if another thread is emitting one at the same time. */
+    buffer = MVM_malloc(record.total_size);
+    memcpy(buffer, &record, sizeof(record));
+    memcpy(buffer + sizeof(record), symbol_name, name_size);
+    memcpy(buffer + sizeof(record) + name_size, (void *)code->func_ptr, code->size);
+    fwrite(buffer, record.total_size, 1, tc->instance->jit_perf_dump);
+    fflush(tc->instance->jit_perf_dump);
+    MVM_free(buffer);
+}
+
+/* Tell external profilers which static frame a piece of JIT output belongs
+ * to, through the perf map file and/or the jitdump file. */
+void MVM_jit_perf_record_code(MVMThreadContext *tc, MVMJitCode *code) {
+    MVMStaticFrame *sf = code->sf;
+    char symbol_name[1024];
+    char *file_location = MVM_staticframe_file_location(tc, sf);
+    char *frame_name = MVM_string_utf8_encode_C_string(tc, sf->body.name);
+    snprintf(symbol_name, sizeof(symbol_name) - 1,
+             "%s(%s)",  frame_name, file_location);
+    if (tc->instance->jit_perf_map) {
+        fprintf(tc->instance->jit_perf_map, "%lx %lx %s\n",
+                (unsigned long) code->func_ptr, code->size, symbol_name);
+        fflush(tc->instance->jit_perf_map);
+    }
+    if (tc->instance->jit_perf_dump)
+        perf_dump_code(tc, code, symbol_name);
+    MVM_free(file_location);
+    MVM_free(frame_name);
+}
+#endif
+
+
 static void dump_tree(MVMThreadContext *tc, MVMJitTreeTraverser *traverser,
                       MVMJitExprTree *tree, MVMint32 node) {
     MVMJitExprInfo *info   = MVM_JIT_EXPR_INFO(tree, node);
@@ -1,6 +1,11 @@
 void MVM_jit_dump_bytecode(MVMThreadContext *tc, MVMJitCode *code);
 void MVM_jit_dump_expr_tree(MVMThreadContext *tc, MVMJitExprTree *tree);
 void MVM_jit_dump_tile_list(MVMThreadContext *tc, MVMJitTileList *list);
+#if linux
+void MVM_jit_perf_dump_open(MVMInstance *instance, const char *dir);
+void MVM_jit_perf_dump_close(MVMInstance *instance);
+void MVM_jit_perf_record_code(MVMThreadContext *tc, MVMJitCode *code);
+#endif
 
 MVM_STATIC_INLINE MVMint32 MVM_jit_debug_enabled(MVMThreadContext *tc) {
     return MVM_spesh_debug_enabled(tc) && tc->instance->jit_debug_enabled;
@@ -9,3 +14,11 @@ MVM_STATIC_INLINE MVMint32 MVM_jit_debug_enabled(MVMThreadContext *tc) {
 MVM_STATIC_INLINE MVMint32 MVM_jit_bytecode_dump_enabled(MVMThreadContext *tc) {
     return tc->instance->jit_bytecode_dir != NULL;
 }
+
+MVM_STATIC_INLINE MVMint32 MVM_jit_perf_record_enabled(MVMThreadContext *tc) {
+#if linux
+    return tc->instance->jit_perf_map != NULL || tc->instance->jit_perf_dump != NULL;
+#else
+    return 0;
+#endif
+}
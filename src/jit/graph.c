@@ -802,6 +802,11 @@ static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                     if (function != NULL)
                         is_double_devirt++;
                 }
+                else if (!alternative && ((MVMObject *)type_facts->type)->st->REPR->ID == MVM_REPR_ID_IntHash) {
+                    function = MVM_IntHash_find_fast_impl_for_jit(tc, ((MVMObject *)type_facts->type)->st, op, kind);
+                    if (function != NULL)
+                        is_double_devirt++;
+                }
                 if (function == NULL) {
                     function = alternative
                         ? (void *)((MVMObject*)type_facts->type)->st->REPR->ass_funcs.at_key
@@ -868,6 +873,11 @@ static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                     if (function != NULL)
                         is_double_devirt++;
                 }
+                else if (!alternative && ((MVMObject *)type_facts->type)->st->REPR->ID == MVM_REPR_ID_IntHash) {
+                    function = MVM_IntHash_find_fast_impl_for_jit(tc, ((MVMObject *)type_facts->type)->st, op, kind);
+                    if (function != NULL)
+                        is_double_devirt++;
+                }
                 if (function == NULL) {
                     function = alternative
                         ? (void *)((MVMObject*)type_facts->type)->st->REPR->ass_funcs.bind_key
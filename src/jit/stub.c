@@ -49,3 +49,15 @@ void * MVM_jit_code_get_current_position(MVMThreadContext *tc, MVMJitCode *code,
 }
 
 void MVM_jit_code_trampoline(MVMThreadContext *tc) {}
+
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMInstance *instance) {
+    return NULL;
+}
+
+void MVM_jit_code_heap_destroy(MVMInstance *instance) {
+}
+
+#if linux
+void MVM_jit_perf_dump_open(MVMInstance *instance, const char *dir) {}
+void MVM_jit_perf_dump_close(MVMInstance *instance) {}
+#endif
@@ -896,6 +896,77 @@ void MVM_jit_tile_list_edit(MVMThreadContext *tc, MVMJitTileList *list) {
     MVM_VECTOR_INIT(list->inserts, 0);
 }
 
+#define IS_LOAD(t)  ((t)->emit == MVM_jit_compile_load)
+#define IS_STORE(t) ((t)->emit == MVM_jit_compile_store)
+#define IS_MOVE(t)  ((t)->emit == MVM_jit_compile_move)
+/* load and store tiles keep the storage class and position in args[0] and
+ * args[1]; a load's register is values[0], a store's is values[1] */
+#define SAME_SLOT(a, b) ((a)->args[0] == (b)->args[0] && (a)->args[1] == (b)->args[1])
+
+static void make_move(MVMJitTile *tile, MVMuint8 dst, MVMuint8 src) {
+    tile->emit       = MVM_jit_compile_move;
+    tile->values[0]  = dst;
+    tile->values[1]  = src;
+    tile->num_refs   = 2;
+    tile->debug_name = "#peephole-move";
+}
+
+/* Peephole pass over the register-allocated tile list. It only considers
+ * directly adjacent tiles within a basic block (definition tiles without
+ * code don't count), which is enough to catch the spill traffic that the
+ * register allocator inserts around definitions and uses. Removed tiles
+ * simply lose their emit rule. Returns the number of tiles removed. */
+MVMuint32 MVM_jit_tile_list_peephole(MVMThreadContext *tc, MVMJitTileList *list) {
+    MVMuint32 i, j, removed = 0;
+    for (i = 0; i < list->blocks_num; i++) {
+        MVMJitTile *prev = NULL;
+        for (j = list->blocks[i].start; j < list->blocks[i].end; j++) {
+            MVMJitTile *tile = list->items[j];
+            MVMint32 redundant = 0;
+            if (tile->emit == NULL)
+                continue;
+            if (IS_MOVE(tile) && tile->values[0] == tile->values[1]) {
+                redundant = 1;
+            }
+            else if (prev != NULL && IS_LOAD(tile) && (IS_STORE(prev) || IS_LOAD(prev)) &&
+                     SAME_SLOT(prev, tile)) {
+                /* Loading what is already in a register: forward it */
+                MVMuint8 src = IS_STORE(prev) ? prev->values[1] : prev->values[0];
+                if (src == tile->values[0])
+                    redundant = 1;
+                else
+                    make_move(tile, tile->values[0], src);
+            }
+            else if (prev != NULL && IS_STORE(tile) && SAME_SLOT(prev, tile) &&
+                     ((IS_STORE(prev) && prev->values[1] == tile->values[1]) ||
+                      (IS_LOAD(prev)  && prev->values[0] == tile->values[1]))) {
+                /* Storing what the slot already holds */
+                redundant = 1;
+            }
+            else if (prev != NULL && IS_MOVE(tile) && IS_MOVE(prev) &&
+                     ((prev->values[0] == tile->values[0] && prev->values[1] == tile->values[1]) ||
+                      (prev->values[0] == tile->values[1] && prev->values[1] == tile->values[0]))) {
+                /* Repeating a move, or moving it straight back */
+                redundant = 1;
+            }
+
+            if (redundant) {
+                tile->emit = NULL;
+                tile->debug_name = "#peephole-removed";
+                removed++;
+            }
+            else {
+                prev = tile;
+            }
+        }
+    }
+    return removed;
+}
+#undef IS_LOAD
+#undef IS_STORE
+#undef IS_MOVE
+#undef SAME_SLOT
+
 void MVM_jit_tile_list_destroy(MVMThreadContext *tc, MVMJitTileList *list) {
     MVM_free(list->items);
     MVM_free(list->inserts);
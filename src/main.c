@@ -95,9 +95,11 @@ The following environment variables are respected:\n\
     MVM_JIT_EXPR_ENABLE         Enable advanced 'expression' JIT\n\
     MVM_JIT_DEBUG               Add JIT debugging information to spesh log\n\
     MVM_JIT_PERF_MAP            Create a map file for the 'perf' profiler (linux only)\n\
+    MVM_JIT_PERF_DUMP           Create a jitdump file with code for 'perf inject --jit' (linux only)\n\
     MVM_JIT_DUMP_BYTECODE       Dump bytecode in temporary directory\n\
     MVM_SPESH_INLINE_LOG        Dump details of inlining attempts to stderr\n\
     MVM_CROSS_THREAD_WRITE_LOG  Log unprotected cross-thread object writes to stderr\n\
+    MVM_DISP_STATS_LOG          Write a per call site dispatch report to this file (or stderr) at exit\n\
     MVM_COVERAGE_LOG            Append (de-duped by default) line-by-line coverage messages to this file\n\
     MVM_COVERAGE_CONTROL        If set to 1, non-de-duping coverage started with nqp::coveragecontrol(1),\n\
                                   if set to 2, non-de-duping coverage started right away\n"
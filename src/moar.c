@@ -233,6 +233,7 @@ MVMInstance * MVM_vm_create_instance(void) {
 
     /* Set up the dispatcher registry, boot dispatchers, and syscalls. */
     MVM_disp_registry_init(instance->main_thread);
+    MVM_disp_megamorphic_init(instance->main_thread);
     MVM_disp_syscall_setup(instance->main_thread);
 
     /* Set up main thread's last_payload. */
@@ -327,8 +328,10 @@ MVMInstance * MVM_vm_create_instance(void) {
 
     /* JIT environment/logging setup. */
     jit_disable = getenv("MVM_JIT_DISABLE");
-    if (MVM_jit_support() && (!jit_disable || !jit_disable[0]))
+    if (MVM_jit_support() && (!jit_disable || !jit_disable[0])) {
         instance->jit_enabled = 1;
+        instance->jit_code_heap = MVM_jit_code_heap_create(instance);
+    }
 
     jit_expr_enable = getenv("MVM_JIT_EXPR_ENABLE");
     if (jit_expr_enable && strlen(jit_expr_enable) != 0)
@@ -351,6 +354,15 @@ MVMInstance * MVM_vm_create_instance(void) {
             instance->jit_perf_map = MVM_platform_fopen(perf_map_filename, "w");
         }
     }
+    {
+        char *jit_perf_dump = getenv("MVM_JIT_PERF_DUMP");
+        if (jit_perf_dump && *jit_perf_dump) {
+            char tmpdir[1024];
+            size_t len = sizeof tmpdir;
+            if (uv_os_tmpdir(tmpdir, &len) == 0)
+                MVM_jit_perf_dump_open(instance, tmpdir);
+        }
+    }
 #endif
 
     {
@@ -435,6 +447,13 @@ MVMInstance * MVM_vm_create_instance(void) {
         instance->cross_thread_write_logging = 0;
     }
 
+    if (getenv("MVM_DISP_STATS_LOG")) {
+        char *disp_stats_log = getenv("MVM_DISP_STATS_LOG");
+        instance->disp_stats = MVM_disp_stats_create(instance, disp_stats_log[0]
+            ? fopen_perhaps_with_pid("MVM_DISP_STATS_LOG", disp_stats_log, "w")
+            : stderr);
+    }
+
     if (getenv("MVM_COVERAGE_LOG")) {
         char *coverage_log = getenv("MVM_COVERAGE_LOG");
         instance->coverage_logging = 1;
@@ -620,6 +639,7 @@ void MVM_vm_exit(MVMInstance *instance) {
         fprintf(instance->dynvar_log_fh, "- x 0 0 0 0 %"PRId64" %"PRIu64" %"PRIu64"\n", instance->dynvar_log_lasttime, uv_hrtime(), uv_hrtime());
         fclose(instance->dynvar_log_fh);
     }
+    MVM_disp_stats_report(instance);
 
 #ifdef HAVE_TELEMEH
     if (getenv("MVM_TELEMETRY_LOG")) {
@@ -654,6 +674,7 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_gc_enter_from_allocator(instance->main_thread);
 
     MVM_profile_instrumented_free_data(instance->main_thread);
+    MVM_disp_stats_report(instance);
 
     /* Run the GC global destruction phase. After this,
      * no 6model object pointers should be accessed. */
@@ -661,8 +682,11 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_ptr_hash_demolish(instance->main_thread, &instance->object_ids);
     MVM_sc_all_scs_destroy(instance->main_thread);
 
-    /* Clean up dispatcher registry and args identity map. */
+    /* Clean up dispatcher registry, megamorphic cache, and args identity
+     * map. */
     MVM_disp_registry_destroy(instance->main_thread);
+    MVM_disp_megamorphic_destroy(instance->main_thread);
+    MVM_disp_stats_destroy(instance);
     MVM_args_destroy_identity_map(instance->main_thread);
 
     /* Cleanup REPR registry */
@@ -732,6 +756,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
         MVM_uni_hash_demolish(instance->main_thread, &instance->unicode_property_values_hashes[i]);
     }
     MVM_free_null(instance->unicode_property_values_hashes);
+    for (int i = 0; i < MVM_NORMALIZE_STABLE_BLOCKS; i++)
+        MVM_free(instance->normalize_stable_blocks[i]);
+    MVM_free_null(instance->normalize_stable_blocks);
 
     MVM_uni_hash_demolish(instance->main_thread, &instance->property_codes_by_names_aliases);
     MVM_uni_hash_demolish(instance->main_thread, &instance->property_codes_by_seq_names);
@@ -744,6 +771,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
         fclose(instance->spesh_log_fh);
     if (instance->jit_perf_map)
         fclose(instance->jit_perf_map);
+#if linux
+    MVM_jit_perf_dump_close(instance);
+#endif
     if (instance->dynvar_log_fh)
         fclose(instance->dynvar_log_fh);
     if (instance->jit_bytecode_dir)
@@ -759,6 +789,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->nfg->update_mutex);
     MVM_nfg_destroy(instance->main_thread);
 
+    /* Clean up JIT code memory; all code using it is gone by now. */
+    MVM_jit_code_heap_destroy(instance);
+
     /* Clean up integer constant and string cache. */
     uv_mutex_destroy(&instance->mutex_int_const_cache);
     MVM_free(instance->int_const_cache);
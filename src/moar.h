@@ -180,8 +180,12 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "disp/registry.h"
 #include "disp/boot.h"
 #include "disp/inline_cache.h"
+#include "disp/megamorphic.h"
+#include "disp/stats.h"
 #include "core/instance.h"
 #include "core/interp.h"
+/* After interp.h, as its entries hold an MVMRegister. */
+#include "core/int_hash_table.h"
 #include "core/callsite.h"
 #include "core/alloc.h"
 #include "core/args.h"
@@ -266,6 +270,7 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "core/index_hash_table_funcs.h"
 #include "core/ptr_hash_table_funcs.h"
 #include "core/uni_hash_table_funcs.h"
+#include "core/int_hash_table_funcs.h"
 #include "6model/containers.h"
 #include "strings/unicode_gen.h"
 #include "strings/unicode.h"
@@ -294,6 +299,7 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "jit/register.h"
 #include "jit/tile.h"
 #include "jit/compile.h"
+#include "jit/code_heap.h"
 #include "jit/dump.h"
 #include "jit/interface.h"
 #include "profiler/instrument.h"
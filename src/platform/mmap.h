@@ -7,3 +7,10 @@ int MVM_platform_set_page_mode(void * block, size_t size, int mode);
 int MVM_platform_free_pages(void *block, size_t size);
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable);
 int MVM_platform_unmap_file(void *block, void *handle, size_t size);
+
+/* Maps the same fresh memory twice, once readable and executable and once
+ * readable and writable, so code can be written without the executable view
+ * ever being writable. Returns the executable view (and the writable one via
+ * the out parameter), or NULL if the platform can't do this. */
+void *MVM_platform_alloc_dual_pages(size_t size, void **writable);
+int MVM_platform_free_dual_pages(void *block, void *writable, size_t size);
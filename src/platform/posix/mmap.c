@@ -3,6 +3,8 @@
 #include "moar.h"
 #include "platform/mmap.h"
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 /* MAP_ANONYMOUS is Linux, MAP_ANON is BSD */
 #ifndef MVM_MAP_ANON
@@ -60,6 +62,46 @@ int MVM_platform_free_pages(void *block, size_t size)
     return munmap(block, size) == 0;
 }
 
+void *MVM_platform_alloc_dual_pages(size_t size, void **writable)
+{
+    int fd;
+    void *exec_view, *write_view;
+#if defined(MFD_CLOEXEC)
+    fd = memfd_create("moar-jit", MFD_CLOEXEC);
+#elif defined(SHM_ANON)
+    fd = shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#else
+    fd = -1;
+#endif
+    if (fd < 0)
+        return NULL;
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return NULL;
+    }
+    exec_view = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    if (exec_view == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    write_view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* The mappings keep the memory alive, we don't need the descriptor. */
+    close(fd);
+    if (write_view == MAP_FAILED) {
+        munmap(exec_view, size);
+        return NULL;
+    }
+    *writable = write_view;
+    return exec_view;
+}
+
+int MVM_platform_free_dual_pages(void *block, void *writable, size_t size)
+{
+    int freed_exec  = munmap(block, size) == 0;
+    int freed_write = munmap(writable, size) == 0;
+    return freed_exec && freed_write;
+}
+
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable)
 {
     void *block = mmap(NULL, size,
@@ -43,6 +43,20 @@ int MVM_platform_free_pages(void *pages, size_t size) {
     return VirtualFree(pages, 0, MEM_RELEASE);
 }
 
+void *MVM_platform_alloc_dual_pages(size_t size, void **writable) {
+    /* Not implemented; callers fall back to MVM_platform_alloc_pages. */
+    (void)size;
+    (void)writable;
+    return NULL;
+}
+
+int MVM_platform_free_dual_pages(void *block, void *writable, size_t size) {
+    (void)block;
+    (void)writable;
+    (void)size;
+    return 0;
+}
+
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable) {
     HANDLE fh, mapping;
     LARGE_INTEGER li;
@@ -4,35 +4,57 @@
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_ascii_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *ascii, size_t bytes) {
     MVMString *result;
-    MVMGrapheme32 *buffer;
+    MVMGrapheme8 *storage;
     size_t i, result_graphs;
+    MVMuint8 invalid = 0;
+    MVMuint8 has_cr = 0;
 
     if (bytes == 0 && tc->instance->str_consts.empty) {
         return tc->instance->str_consts.empty;
     }
 
-    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bytes);
-
-    result_graphs = 0;
+    /* ASCII always fits in 8-bit storage (as does the \r\n synthetic, being
+     * the first one created), so check the input up front and then decode
+     * straight into a buffer no bigger than the input itself. */
+    MVM_VECTORIZE_LOOP
     for (i = 0; i < bytes; i++) {
-        if (ascii[i] == '\r' && i + 1 < bytes && ascii[i + 1] == '\n') {
-            buffer[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
-            i++;
-        }
-        /* `ascii[i] < 0` is always false on platforms where char is unsigned.
-         * This expression works whatever plain char is. */
-        else if ((ascii[i] & 0x80) == 0) {
-            buffer[result_graphs++] = ascii[i];
-        }
-        else {
-            MVM_free(buffer);
-            MVM_exception_throw_adhoc(tc,
-                "Will not decode invalid ASCII (code point (%"PRId32") < 0 found)", ascii[i]);
-        }
+        invalid |= ascii[i] & 0x80;
+        has_cr  |= ascii[i] == '\r';
+    }
+    if (invalid) {
+        for (i = 0; (ascii[i] & 0x80) == 0; i++)
+            ;
+        MVM_exception_throw_adhoc(tc,
+            "Will not decode invalid ASCII (code point (%"PRId32") < 0 found)", (MVMint32)ascii[i]);
     }
+
     result = (MVMString *)REPR(result_type)->allocate(tc, STABLE(result_type));
-    result->body.storage.blob_32 = buffer;
-    result->body.storage_type = MVM_STRING_GRAPHEME_32;
+    if (bytes <= 8) {
+        result->body.storage_type   = MVM_STRING_IN_SITU_8;
+        storage = result->body.storage.in_situ_8;
+    }
+    else {
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.storage.blob_8 = MVM_malloc(bytes);
+        storage = result->body.storage.blob_8;
+    }
+
+    if (has_cr) {
+        result_graphs = 0;
+        for (i = 0; i < bytes; i++) {
+            if (ascii[i] == '\r' && i + 1 < bytes && ascii[i + 1] == '\n') {
+                storage[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
+                i++;
+            }
+            else {
+                storage[result_graphs++] = ascii[i];
+            }
+        }
+    }
+    else {
+        memcpy(storage, ascii, bytes);
+        result_graphs = bytes;
+    }
     result->body.num_graphs = result_graphs;
 
     return result;
@@ -78,8 +100,26 @@ MVMuint32 MVM_string_ascii_decodestream(MVMThreadContext *tc, MVMDecodeStream *d
         MVMint32  pos   = cur_bytes == ds->bytes_head ? ds->bytes_head_pos : 0;
         MVMuint8 *bytes = (MVMuint8*)cur_bytes->bytes;
         while (pos < cur_bytes->length) {
-            MVMCodepoint codepoint = bytes[pos++];
+            MVMCodepoint codepoint;
             MVMGrapheme32 graph;
+            if (!last_was_cr) {
+                /* Take a run of ASCII other than \r up to any separator or
+                 * the stopper in one go. */
+                MVMint32 run = MVM_string_ascii_run_length(bytes + pos, cur_bytes->length - pos);
+                if (run > 0) {
+                    pos += MVM_string_decodestream_append_run(tc, ds, seps,
+                        stopper_chars, bytes + pos, run, &buffer, &count, bufsize, &total);
+                    last_accept_bytes = cur_bytes;
+                    last_accept_pos = pos;
+                    if (stopper_chars && *stopper_chars == total) {
+                        reached_stopper = 1;
+                        goto done;
+                    }
+                    if (pos == cur_bytes->length)
+                        break;
+                }
+            }
+            codepoint = bytes[pos++];
             if (codepoint > 127) {
                 MVM_free(buffer);
                 MVM_exception_throw_adhoc(tc,
@@ -5,3 +5,23 @@ MVM_PUBLIC char * MVM_string_ascii_encode_substr(MVMThreadContext *tc, MVMString
 MVM_PUBLIC char * MVM_string_ascii_encode(MVMThreadContext *tc, MVMString *str, MVMuint64 *output_size, MVMint32 translate_newlines);
 char * MVM_string_ascii_encode_any(MVMThreadContext *tc, MVMString *str);
 char * MVM_string_ascii_encode_malloc(MVMThreadContext *tc, MVMString *str);
+
+/* Counts the leading bytes that are ASCII other than \r. Each such byte is a
+ * whole codepoint, and a grapheme of its own under NFG, except that the last
+ * one may yet combine with whatever follows it. We look at a word at a time,
+ * checking high bits for non-ASCII bytes and using the usual zero byte trick
+ * to spot \r, then find the exact position in the word that ends the run. */
+MVM_STATIC_INLINE size_t MVM_string_ascii_run_length(const MVMuint8 *bytes, size_t len) {
+    size_t i = 0;
+    while (i + 8 <= len) {
+        MVMuint64 word, cr;
+        memcpy(&word, bytes + i, 8);
+        cr = word ^ 0x0D0D0D0D0D0D0D0DULL;
+        if ((word | ((cr - 0x0101010101010101ULL) & ~cr)) & 0x8080808080808080ULL)
+            break;
+        i += 8;
+    }
+    while (i < len && bytes[i] < 0x80 && bytes[i] != '\r')
+        i++;
+    return i;
+}
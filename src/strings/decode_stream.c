@@ -73,6 +73,79 @@ static void free_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMDecodeStrea
         ds->chars_reuse = chars;
 }
 
+/* Decoded chars are buffered 32 bits wide, but the strings we make from them
+ * may well be long-lived (a whole slurped file, or every line of one), so when
+ * they turn out to fit in 8 bits we store them that way, in a quarter of the
+ * memory. */
+static void copy_chars_8bit(MVMGrapheme8 *to, const MVMGrapheme32 *from, MVMint32 length) {
+    MVMint32 i;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++)
+        to[i] = from[i];
+}
+static MVMGrapheme8 * result_storage_8bit(MVMThreadContext *tc, MVMString *result, MVMint32 length) {
+    if (length <= 8) {
+        result->body.storage_type = MVM_STRING_IN_SITU_8;
+        return result->body.storage.in_situ_8;
+    }
+    result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+    result->body.storage.blob_8 = MVM_malloc(length);
+    return result->body.storage.blob_8;
+}
+static void narrow_result(MVMThreadContext *tc, MVMString *result) {
+    MVMGrapheme32 *chars = result->body.storage.blob_32;
+    MVMint32 length = result->body.num_graphs;
+    if (MVM_string_buf32_can_fit_into_8bit(chars, length)) {
+        copy_chars_8bit(result_storage_8bit(tc, result, length), chars, length);
+        MVM_free(chars);
+    }
+}
+
+/* Appends to a decoder's result buffer a run of bytes that each decode to
+ * the grapheme of the same value, such as ASCII or Latin-1 other than \r,
+ * attaching the buffer to the stream and starting a new one as it fills.
+ * Stops short of any byte that is the final grapheme of a separator, which
+ * the decoder must then handle as usual, and of going past the stopper.
+ * Separators are found using memchr, which C libraries vectorize, rather
+ * than checking every byte against every separator. Returns the number of
+ * bytes appended. */
+MVMint32 MVM_string_decodestream_append_run(MVMThreadContext *tc, MVMDecodeStream *ds,
+        MVMDecodeStreamSeparators *seps, const MVMuint32 *stopper_chars, const MVMuint8 *bytes,
+        MVMint32 length, MVMGrapheme32 **buffer, MVMuint32 *count, MVMuint32 bufsize, MVMuint32 *total) {
+    MVMint32 appended = 0;
+    if (stopper_chars && (MVMint64)*stopper_chars - *total < length)
+        length = *stopper_chars - *total;
+    if (seps) {
+        MVMint32 i;
+        for (i = 0; i < seps->num_seps && length > 0; i++) {
+            MVMGrapheme32 g = seps->final_graphemes[i];
+            if (0 <= g && g < 0x100) {
+                const MVMuint8 *sep = memchr(bytes, g, length);
+                if (sep)
+                    length = sep - bytes;
+            }
+        }
+    }
+    while (appended < length) {
+        MVMint32 chunk = length - appended;
+        MVMint32 i;
+        if (*count == bufsize) {
+            MVM_string_decodestream_add_chars(tc, ds, *buffer, bufsize);
+            *buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+            *count = 0;
+        }
+        if ((MVMuint32)chunk > bufsize - *count)
+            chunk = bufsize - *count;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < chunk; i++)
+            (*buffer)[*count + i] = bytes[appended + i];
+        *count    += chunk;
+        appended  += chunk;
+    }
+    *total += appended;
+    return appended;
+}
+
 /* Throws away byte buffers no longer needed. */
 void MVM_string_decodestream_discard_to(MVMThreadContext *tc, MVMDecodeStream *ds, const MVMDecodeStreamBytes *bytes, MVMint32 pos) {
     while (ds->bytes_head != bytes) {
@@ -303,6 +376,7 @@ static MVMString * take_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint3
             }
         }
     }
+    narrow_result(tc, result);
     return result;
 }
 MVMString * MVM_string_decodestream_get_chars(MVMThreadContext *tc, MVMDecodeStream *ds,
@@ -420,10 +494,109 @@ static MVMint32 find_separator(MVMThreadContext *tc, const MVMDecodeStream *ds,
     }
     return 0;
 }
+/* For encodings where ASCII is encoded as itself, tries to find the next line
+ * in the raw bytes of the head buffer and make a string of it directly, with
+ * no trip through the decoder and its grapheme buffers. This applies when
+ * nothing is decoded and waiting, the separators are all single graphemes
+ * that are ASCII or \r\n, and the line is ASCII other than \r and ends
+ * within the buffer. Returns NULL if that isn't the case, having changed
+ * nothing. */
+static MVMString * get_line_from_bytes(MVMThreadContext *tc, MVMDecodeStream *ds,
+                                       MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp) {
+    MVMDecodeStreamBytes *head = ds->bytes_head;
+    MVMGrapheme32 crlf = MVM_unicode_normalizer_translated_crlf(tc, &(ds->norm));
+    MVMint32 crlf_is_sep = 0, line_length = -1, sep_bytes = 0, run, i;
+    MVMGrapheme32 sep_graph = 0;
+    MVMString *result;
+    MVMGrapheme8 *storage;
+    const MVMuint8 *bytes;
+    size_t available;
+
+    if (!head || ds->chars_head || !MVM_unicode_normalizer_empty(tc, &(ds->norm)))
+        return NULL;
+    switch (ds->encoding) {
+        case MVM_encoding_type_utf8:
+            /* There may be a BOM to skip at the very start. */
+            if (ds->abs_byte_pos == 0)
+                return NULL;
+            break;
+        case MVM_encoding_type_ascii:
+        case MVM_encoding_type_latin1:
+            break;
+        default:
+            return NULL;
+    }
+    for (i = 0; i < sep_spec->num_seps; i++) {
+        MVMGrapheme32 g = sep_spec->final_graphemes[i];
+        if (sep_spec->sep_lengths[i] != 1)
+            return NULL;
+        /* With newline translation, \r\n is read as \n. */
+        if (g == crlf)
+            crlf_is_sep = 1;
+        else if (g < 0 || g >= 0x80 || g == '\r')
+            return NULL;
+    }
+
+    /* Look for the first separator in the leading run of ASCII other than
+     * \r. One that isn't a control character could combine with a mark that
+     * follows it, so we need to see an ASCII byte after it to be sure. */
+    bytes     = (const MVMuint8 *)head->bytes + ds->bytes_head_pos;
+    available = head->length - ds->bytes_head_pos;
+    run       = MVM_string_ascii_run_length(bytes, available);
+    for (i = 0; i < sep_spec->num_seps; i++) {
+        MVMGrapheme32 g = sep_spec->final_graphemes[i];
+        if (g >= 0) {
+            const MVMuint8 *sep = memchr(bytes, g, line_length >= 0 ? line_length : run);
+            if (sep) {
+                line_length = sep - bytes;
+                sep_graph   = g;
+                sep_bytes   = 1;
+            }
+        }
+    }
+    if (line_length >= 0) {
+        if (sep_graph >= 0x20 && ((size_t)line_length + 1 >= available || bytes[line_length + 1] >= 0x80))
+            return NULL;
+    }
+
+    /* Otherwise, the run may end in a \r\n that is a separator. */
+    else if (crlf_is_sep && (size_t)run + 1 < available && bytes[run] == '\r' && bytes[run + 1] == '\n') {
+        line_length = run;
+        sep_graph   = crlf;
+        sep_bytes   = 2;
+    }
+    else {
+        return NULL;
+    }
+
+    /* Make the string, and consume the bytes. */
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.num_graphs = line_length + (chomp ? 0 : 1);
+    if (result->body.num_graphs <= 8) {
+        result->body.storage_type = MVM_STRING_IN_SITU_8;
+        storage = result->body.storage.in_situ_8;
+    }
+    else {
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.storage.blob_8 = MVM_malloc(result->body.num_graphs);
+        storage = result->body.storage.blob_8;
+    }
+    memcpy(storage, bytes, line_length);
+    if (!chomp)
+        storage[line_length] = sep_graph;
+    MVM_string_decodestream_discard_to(tc, ds, head, ds->bytes_head_pos + line_length + sep_bytes);
+    return result;
+}
+
 MVMString * MVM_string_decodestream_get_until_sep(MVMThreadContext *tc, MVMDecodeStream *ds,
                                                   MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp) {
     MVMint32 sep_loc, sep_length;
 
+    /* Lines of ASCII can often be had without decoding. */
+    MVMString *from_bytes = get_line_from_bytes(tc, ds, sep_spec, chomp);
+    if (from_bytes)
+        return from_bytes;
+
     /* Look for separator, trying more decoding if it fails. We get the place
      * just beyond the separator, so can use take_chars to get what's need.
      * Note that decoders are only responsible for finding the final char of
@@ -487,6 +660,7 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
         /* Set up result string. */
         result->body.storage.blob_32 = ds->chars_head->chars;
         result->body.num_graphs      = ds->chars_head->length;
+        narrow_result(tc, result);
 
         /* Don't free the buffer's memory itself, just the holder, as we
          * stole that for the buffer into the string above. */
@@ -496,36 +670,39 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
 
     /* Otherwise, need to assemble all the things. */
     else {
-        /* Calculate length. */
-        MVMint32 length = 0, pos = 0;
+        /* Calculate length, and whether it all fits in 8 bits; we check that
+         * before assembling so as not to need a 32-bit copy of everything. */
+        MVMint32 length = 0, pos = 0, fits_8bit = 1;
+        MVMGrapheme8 *storage_8 = NULL;
         MVMDecodeStreamChars *cur_chars = ds->chars_head;
         while (cur_chars) {
-            if (cur_chars == ds->chars_head)
-                length += cur_chars->length - ds->chars_head_pos;
-            else
-                length += cur_chars->length;
+            MVMint32 from = cur_chars == ds->chars_head ? ds->chars_head_pos : 0;
+            length += cur_chars->length - from;
+            if (fits_8bit)
+                fits_8bit = MVM_string_buf32_can_fit_into_8bit(cur_chars->chars + from,
+                    cur_chars->length - from);
             cur_chars = cur_chars->next;
         }
 
         /* Allocate a result buffer of the right size. */
-        result->body.storage.blob_32 = MVM_malloc(length * sizeof(MVMGrapheme32));
-        result->body.num_graphs      = length;
+        if (fits_8bit)
+            storage_8 = result_storage_8bit(tc, result, length);
+        else
+            result->body.storage.blob_32 = MVM_malloc(length * sizeof(MVMGrapheme32));
+        result->body.num_graphs = length;
 
         /* Copy all the things into the target, freeing as we go. */
         cur_chars = ds->chars_head;
         while (cur_chars) {
             MVMDecodeStreamChars *next_chars = cur_chars->next;
-            if (cur_chars == ds->chars_head) {
-                MVMint32 to_copy = ds->chars_head->length - ds->chars_head_pos;
-                memcpy(result->body.storage.blob_32 + pos, cur_chars->chars + ds->chars_head_pos,
+            MVMint32 from = cur_chars == ds->chars_head ? ds->chars_head_pos : 0;
+            MVMint32 to_copy = cur_chars->length - from;
+            if (fits_8bit)
+                copy_chars_8bit(storage_8 + pos, cur_chars->chars + from, to_copy);
+            else
+                memcpy(result->body.storage.blob_32 + pos, cur_chars->chars + from,
                     to_copy * sizeof(MVMGrapheme32));
-                pos += to_copy;
-            }
-            else {
-                memcpy(result->body.storage.blob_32 + pos, cur_chars->chars,
-                    cur_chars->length * sizeof(MVMGrapheme32));
-                pos += cur_chars->length;
-            }
+            pos += to_copy;
             MVM_free(cur_chars->chars);
             free_chars(tc, ds, cur_chars);
             cur_chars = next_chars;
@@ -120,8 +120,27 @@ MVMuint32 MVM_string_latin1_decodestream(MVMThreadContext *tc, MVMDecodeStream *
         MVMint32  pos = cur_bytes == ds->bytes_head ? ds->bytes_head_pos : 0;
         MVMuint8 *bytes = cur_bytes->bytes;
         while (pos < cur_bytes->length) {
-            MVMCodepoint codepoint = bytes[pos++];
+            MVMCodepoint codepoint;
             MVMGrapheme32 graph;
+            if (!last_was_cr) {
+                /* Take a run of Latin-1 other than \r up to any separator or
+                 * the stopper in one go. */
+                const MVMuint8 *cr = memchr(bytes + pos, '\r', cur_bytes->length - pos);
+                MVMint32 run = cr ? cr - (bytes + pos) : cur_bytes->length - pos;
+                if (run > 0) {
+                    pos += MVM_string_decodestream_append_run(tc, ds, seps,
+                        stopper_chars, bytes + pos, run, &buffer, &count, bufsize, &total);
+                    last_accept_bytes = cur_bytes;
+                    last_accept_pos = pos;
+                    if (stopper_chars && *stopper_chars == total) {
+                        reached_stopper = 1;
+                        goto done;
+                    }
+                    if (pos == cur_bytes->length)
+                        break;
+                }
+            }
+            codepoint = bytes[pos++];
             if (last_was_cr) {
                 if (codepoint == '\n') {
                     graph = MVM_unicode_normalizer_translated_crlf(tc, &(ds->norm));
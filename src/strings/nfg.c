@@ -4,138 +4,105 @@
  * to grow it. */
 #define MVM_SYNTHETIC_GROW_ELEMS 32
 
-/* Finds the index of a given codepoint within a trie node. Returns it if
- * there is one, or negative if there is not (note 0 is a valid index). */
-static MVMint32 find_child_node_idx(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
-    if (node) {
-        /* TODO: update this to do a binary search later on. */
-        MVMint32 i;
-        for (i = 0; i < node->num_entries; i++)
-            if (node->next_codes[i].code == cp)
-                return i;
-    }
-    return -1;
+/* Initial number of slots in the lookup table, as a power of 2; the table
+ * is grown when it becomes three quarters full. */
+#define MVM_NFG_LOOKUP_INITIAL_LOG2 6
+
+/* Hashes a codepoint sequence, using Fibonacci hashing on each codepoint in
+ * turn. The top bits of the result pick a slot. */
+static MVMuint64 hash_codes(const MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint64 hash = num_codes;
+    MVMint32 i;
+    for (i = 0; i < num_codes; i++)
+        hash = (hash ^ (MVMuint32)codes[i]) * UINT64_C(11400714819323198485);
+    return hash;
 }
-
-/* Does a lookup in the trie for a synthetic for the specified codepoints. */
-static MVMNFGTrieNode * find_child_node(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
-    MVMint32 idx = find_child_node_idx(tc, node, cp);
-    return idx >= 0 ? node->next_codes[idx].node : NULL;
+MVM_STATIC_INLINE MVMuint32 slot_for_hash(const MVMNFGLookupTable *table, MVMuint64 hash) {
+    return (MVMuint32)(hash >> (64 - table->log2_slots));
 }
+
+/* Does a lookup in the table for a synthetic for the specified codepoints.
+ * This takes no lock: entries are only ever added, and are in place before
+ * the slot referencing them is set, while a table that was replaced by a
+ * bigger one lives on until the next safe point. At worst we miss something
+ * added just now, and the caller re-checks under the lock. */
 static MVMGrapheme32 lookup_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
-    MVMNFGTrieNode *cur_node        = tc->instance->nfg->grapheme_lookup;
-    MVMCodepoint   *cur_code        = codes;
-    MVMint32        codes_remaining = num_codes;
-    while (cur_node && codes_remaining) {
-        cur_node = find_child_node(tc, cur_node, *cur_code);
-        cur_code++;
-        codes_remaining--;
+    MVMNFGLookupTable *table = tc->instance->nfg->grapheme_lookup;
+    MVMuint64 hash;
+    MVMuint32 mask, slot;
+    if (!table)
+        return 0;
+    hash = hash_codes(codes, num_codes);
+    mask = (1 << table->log2_slots) - 1;
+    slot = slot_for_hash(table, hash);
+    while (1) {
+        MVMNFGLookupEntry *entry = table->slots[slot];
+        if (!entry)
+            return 0;
+        if (entry->hash == hash && entry->num_codes == num_codes
+                && memcmp(entry->codes, codes, num_codes * sizeof(MVMCodepoint)) == 0)
+            return entry->graph;
+        slot = (slot + 1) & mask;
     }
-    return cur_node ? cur_node->graph : 0;
 }
 
-/* Recursive algorithm to add to the trie. Descends existing trie nodes so far
- * as we have them following the code points, then passes on a NULL for the
- * levels of current below that do not exist. Once we bottom out, makes a copy
- * of or creates a node for the synthetic. As we walk back up we create or
- * copy+tweak nodes until we have produced a new trie, re-using what we can of
- * the existing one. */
-static MVMNFGTrieNode * twiddle_trie_node(MVMThreadContext *tc, MVMNFGTrieNode *current, MVMCodepoint *cur_code, MVMint32 codes_remaining, MVMGrapheme32 synthetic) {
-    /* Make a new empty node, which we'll maybe copy some things from the
-     * current node into. */
-    MVMNFGTrieNode *new_node = MVM_malloc(sizeof(MVMNFGTrieNode));
-
-    /* If we've more codes remaining... */
-    if (codes_remaining > 0) {
-        /* Recurse, to get a new child node. */
-        MVMint32 idx = find_child_node_idx(tc, current, *cur_code);
-        MVMNFGTrieNode *new_child = twiddle_trie_node(tc,
-            idx >= 0 ? current->next_codes[idx].node : NULL,
-            cur_code + 1, codes_remaining - 1, synthetic);
-
-        /* If we had an existing child node... */
-        if (idx >= 0) {
-            /* Make a copy of the next_codes list. */
-            size_t the_size = current->num_entries * sizeof(MVMNFGTrieNodeEntry);
-            MVMNFGTrieNodeEntry *new_next_codes = MVM_malloc(the_size);
-            memcpy(new_next_codes, current->next_codes, the_size);
-
-            /* Update the copy to point to the new child. */
-            new_next_codes[idx].node = new_child;
-
-            /* Install the new next_codes list in the new node, and free the
-             * existing child list at the next safe point. */
-            new_node->num_entries = current->num_entries;
-            new_node->next_codes  = new_next_codes;
-            MVM_free_at_safepoint(tc, current->next_codes);
-        }
+/* Places an entry into the first free slot for it. Assumes there is one. */
+static void insert_entry(MVMNFGLookupTable *table, MVMNFGLookupEntry *entry) {
+    MVMuint32 mask = (1 << table->log2_slots) - 1;
+    MVMuint32 slot = slot_for_hash(table, entry->hash);
+    while (table->slots[slot])
+        slot = (slot + 1) & mask;
+    table->slots[slot] = entry;
+    table->used++;
+}
 
-        /* Otherwise, we're going to need to insert the new child into a
-         * (possibly existing) child list. */
-        else {
-            /* Calculate new child node list size and allocate it. */
-            MVMint32 orig_entries = current ? current->num_entries : 0;
-            MVMint32 new_entries  = orig_entries + 1;
-            size_t new_size       = new_entries * sizeof(MVMNFGTrieNodeEntry);
-            MVMNFGTrieNodeEntry *new_next_codes = MVM_malloc(new_size);
-
-            /* Go through original entries, copying those that are for a lower
-             * code point than the one we're inserting a child for. */
-            MVMint32 insert_pos = 0;
-            MVMint32 orig_pos   = 0;
-            while (orig_pos < orig_entries && current->next_codes[orig_pos].code < *cur_code)
-                new_next_codes[insert_pos++] = current->next_codes[orig_pos++];
-
-            /* Insert the new child. */
-            new_next_codes[insert_pos].code = *cur_code;
-            new_next_codes[insert_pos].node = new_child;
-            insert_pos++;
-
-            /* Copy the rest. */
-            while (orig_pos < orig_entries)
-                new_next_codes[insert_pos++] = current->next_codes[orig_pos++];
-
-            /* Install the new next_codes list in the new node, and free any
-             * existing child list at the next safe point. */
-            new_node->num_entries = new_entries;
-            new_node->next_codes  = new_next_codes;
-            if (orig_entries)
-                MVM_free_at_safepoint(tc, current->next_codes);
-        }
+/* Makes an empty lookup table, or a bigger copy of an existing one. */
+static MVMNFGLookupTable * make_table(MVMThreadContext *tc, MVMNFGLookupTable *orig) {
+    MVMuint8 log2_slots = orig ? orig->log2_slots + 1 : MVM_NFG_LOOKUP_INITIAL_LOG2;
+    MVMNFGLookupTable *table = MVM_calloc(1, sizeof(MVMNFGLookupTable)
+        + ((1 << log2_slots) - 1) * sizeof(MVMNFGLookupEntry *));
+    table->log2_slots = log2_slots;
+    if (orig) {
+        MVMuint32 i, num_slots = 1 << orig->log2_slots;
+        for (i = 0; i < num_slots; i++)
+            if (orig->slots[i])
+                insert_entry(table, orig->slots[i]);
+    }
+    return table;
+}
 
-        /* Always need to copy synthetic set on the existing node also;
-         * otherwise make sure to clear it. */
-        new_node->graph = current ? current->graph : 0;
+/* Adds a synthetic to the lookup table. Assumes that we are holding the lock
+ * that serializes updates. */
+static void add_synthetic_to_lookup(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMGrapheme32 synthetic) {
+    MVMNFGState       *nfg   = tc->instance->nfg;
+    MVMNFGLookupTable *table = nfg->grapheme_lookup;
+    MVMNFGLookupEntry *entry = MVM_malloc(sizeof(MVMNFGLookupEntry));
+    entry->hash      = hash_codes(codes, num_codes);
+    entry->codes     = codes;
+    entry->num_codes = num_codes;
+    entry->graph     = synthetic;
+
+    /* If the table is missing or would become too full, publish a bigger
+     * one with the new entry already in it. */
+    if (!table || (table->used + 1) * 4 > (MVMuint32)(3 << table->log2_slots)) {
+        MVMNFGLookupTable *new_table = make_table(tc, table);
+        insert_entry(new_table, entry);
+        MVM_barrier();
+        nfg->grapheme_lookup = new_table;
+        if (table)
+            MVM_free_at_safepoint(tc, table);
     }
 
-    /* Otherwise, we reached the point where we need to install the synthetic.
-     * If we already had a node here, we re-use the children of it. */
+    /* Otherwise, make sure the entry is complete before making it visible
+     * in a slot. */
     else {
-        new_node->graph = synthetic;
-        if (current) {
-            new_node->num_entries = current->num_entries;
-            new_node->next_codes  = current->next_codes;
-        }
-        else {
-            new_node->num_entries = 0;
-            new_node->next_codes  = NULL;
-        }
+        MVM_barrier();
+        insert_entry(table, entry);
     }
-
-    /* Free any existing node at next safe point, return the new one. */
-    if (current)
-        MVM_free_at_safepoint(tc, current);
-    return new_node;
-}
-static void add_synthetic_to_trie(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMGrapheme32 synthetic) {
-    MVMNFGState    *nfg      = tc->instance->nfg;
-    MVMNFGTrieNode *new_trie = twiddle_trie_node(tc, nfg->grapheme_lookup, codes, num_codes, synthetic);
-    MVM_barrier();
-    nfg->grapheme_lookup = new_trie;
 }
 
 /* Assumes that we are holding the lock that serializes updates, and already
- * checked that the synthetic does not exist. Adds it to the lookup trie and
+ * checked that the synthetic does not exist. Adds it to the lookup table and
  * synthetics table, making sure to do enough copy/free-at-safe-point work to
  * not upset other threads possibly doing concurrent reads. */
 static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
@@ -208,14 +175,14 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
     /* Give the synthetic an ID by negating the new number of synthetics. */
     result = -(nfg->num_synthetics);
 
-    /* Make an entry in the lookup trie for the new synthetic, so we can use
+    /* Make an entry in the lookup table for the new synthetic, so we can use
      * it in the future when seeing the same codepoint sequence. */
-    add_synthetic_to_trie(tc, codes, num_codes, result);
+    add_synthetic_to_lookup(tc, synth->codes, num_codes, result);
 
     return result;
 }
 
-/* Does a lookup of a synthetic in the trie. If we find one, returns it. If
+/* Does a lookup of a synthetic in the table. If we find one, returns it. If
  * not, acquires the update lock, re-checks that we really are missing the
  * synthetic, and then adds it. */
 static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
@@ -392,17 +359,21 @@ MVM_STATIC_INLINE MVMint32 codepoint_GCB_Control (MVMThreadContext *tc, MVMCodep
 /* Returns non-zero if the result of concatenating the two strings will freely
  * leave us in NFG without any further effort. */
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b) {
-    MVMGrapheme32 last_a;
-    MVMGrapheme32 first_b;
-    MVMGrapheme32 crlf;
-
     /* If either string is empty, we're good. */
     if (a->body.num_graphs == 0 || b->body.num_graphs == 0)
         return 1;
 
-    /* Get first and last graphemes of the strings. */
-    last_a  = MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1);
-    first_b = MVM_string_get_grapheme_at_nocheck(tc, b, 0);
+    /* Otherwise, it's down to the last and first graphemes of the strings. */
+    return MVM_nfg_is_grapheme_concat_stable(tc,
+        MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1),
+        MVM_string_get_grapheme_at_nocheck(tc, b, 0));
+}
+
+/* Returns non-zero if a string ending in the grapheme last_a can have a
+ * string starting with first_b appended and still be in NFG. */
+MVMint32 MVM_nfg_is_grapheme_concat_stable(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b) {
+    MVMGrapheme32 crlf;
+
     /* Put the case where we are adding a lf or crlf line ending */
     if (first_b == '\n')
         /* If we see \r + \n we need to renormalize. Otherwise we're good */
@@ -465,24 +436,21 @@ void MVM_nfg_init(MVMThreadContext *tc) {
     cache_crlf(tc);
 }
 
-static void nfg_trie_node_destroy(MVMThreadContext *tc, MVMNFGTrieNode *node) {
-    MVMint32 i = 0;
-    for(; i < node->num_entries; i++) {
-        nfg_trie_node_destroy(tc, node->next_codes[i].node);
-    }
-    if (node->next_codes)
-        MVM_free(node->next_codes);
-    MVM_free(node);
-}
-
 /* Free all memory allocated to hold synthetic graphemes. These are global
  * to a VM instance. */
 void MVM_nfg_destroy(MVMThreadContext *tc) {
     MVMNFGState *nfg = tc->instance->nfg;
     MVMuint32 i;
 
-    if (nfg->grapheme_lookup)
-        nfg_trie_node_destroy(tc, nfg->grapheme_lookup);
+    /* Free the lookup table and its entries. */
+    if (nfg->grapheme_lookup) {
+        MVMNFGLookupTable *table = nfg->grapheme_lookup;
+        MVMuint32 num_slots = 1 << table->log2_slots;
+        for (i = 0; i < num_slots; i++)
+            if (table->slots[i])
+                MVM_free(table->slots[i]);
+        MVM_free(table);
+    }
 
     /* Free all synthetics. */
     if (nfg->synthetics) {
@@ -10,9 +10,9 @@ struct MVMNFGState {
      * synthetic S, we look up in this table with (-S - 1). */
     MVMNFGSynthetic *synthetics;
 
-    /* Trie used to do lookups by codepoints (already in NFC) to an (NFG)
-     * grapheme. */
-    MVMNFGTrieNode *grapheme_lookup;
+    /* Hash table used to do lookups by codepoints (already in NFC) to an
+     * (NFG) grapheme. */
+    MVMNFGLookupTable *grapheme_lookup;
 
     /* Mutex used when we wish to do updates to the grapheme table. */
     uv_mutex_t update_mutex;
@@ -53,27 +53,34 @@ struct MVMNFGSynthetic {
     MVMint32 is_utf8_c8;
 };
 
-/* A node in the NFG trie. */
-struct MVMNFGTrieNode {
-    /* Set of entries for further traversal, sorted ascending on codepoint
-     * so we can find an entry using binary search. */
-    MVMNFGTrieNodeEntry *next_codes;
-
-    /* Number of entries in next_cps. */
-    MVMint32 num_entries;
-
-    /* Non-zero if we reach a result at this node (and will always be negative
-     * since it's an NFG synthetic). */
-    MVMGrapheme32 graph;
+/* The table used to look up synthetics by their codepoints. It is open
+ * addressed with linear probing, and only ever has entries added to it, with
+ * an entry being fully set up before the slot pointing to it is filled in;
+ * readers can thus probe it without taking a lock. When it gets too full, a
+ * table twice the size is made and swapped in, and the old one is freed at
+ * the next safe point (the entries themselves are shared between the two). */
+struct MVMNFGLookupTable {
+    /* Number of slots in use. */
+    MVMuint32 used;
+
+    /* Base 2 log of the number of slots. */
+    MVMuint8 log2_slots;
+
+    /* The slots, each NULL or pointing to an entry. */
+    MVMNFGLookupEntry *slots[1];
 };
 
-/* An entry in the list of next possible codepoints in the NFG trie. */
-struct MVMNFGTrieNodeEntry {
-    /* The codepoint. */
-    MVMCodepoint code;
+/* An entry in the NFG lookup table. */
+struct MVMNFGLookupEntry {
+    /* Hash of the codepoints. */
+    MVMuint64 hash;
 
-    /* Trie node to traverse to if we find this node. */
-    MVMNFGTrieNode *node;
+    /* The codepoints, owned by the synthetic, and how many of them. */
+    MVMCodepoint *codes;
+    MVMint32 num_codes;
+
+    /* The synthetic they map to. */
+    MVMGrapheme32 graph;
 };
 
 /* The maximum number of codepoints we will allow in a synthetic grapheme.
@@ -88,6 +95,7 @@ MVMGrapheme32 MVM_nfg_crlf_grapheme(MVMThreadContext *tc);
 MVMNFGSynthetic * MVM_nfg_get_synthetic_info(MVMThreadContext *tc, MVMGrapheme32 synth);
 MVMuint32 MVM_nfg_get_case_change(MVMThreadContext *tc, MVMGrapheme32 codepoint, MVMint32 case_, MVMGrapheme32 **result);
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b);
+MVMint32 MVM_nfg_is_grapheme_concat_stable(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b);
 
 /* NFG subsystem initialization and cleanup. */
 void MVM_nfg_init(MVMThreadContext *tc);
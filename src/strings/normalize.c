@@ -520,6 +520,41 @@ static MVMint32 is_grapheme_prepend(MVMThreadContext *tc, MVMCodepoint cp) {
     return MVM_unicode_codepoint_get_property_int(tc, cp,
         MVM_UNICODE_PROPERTY_PREPENDED_CONCATENATION_MARK);
 }
+/* Works out if a codepoint is stable, as described at
+ * MVM_unicode_normalizer_is_stable. This mirrors the checks that the full
+ * path of normalization makes before swapping one codepoint for another. */
+static MVMint32 compute_stable(MVMThreadContext *tc, MVMCodepoint cp) {
+    const char *nfc_qc, *nfg_qc;
+    if (MVM_unicode_codepoint_get_property_int(tc, cp,
+            MVM_UNICODE_PROPERTY_GRAPHEME_CLUSTER_BREAK) != MVM_UNICODE_PVALUE_GCB_OTHER)
+        return 0;
+    if (is_grapheme_prepend(tc, cp) || MVM_string_is_control_full(tc, cp))
+        return 0;
+    if (MVM_unicode_relative_ccc(tc, cp) != 0)
+        return 0;
+    nfc_qc = MVM_unicode_codepoint_get_property_cstr(tc, cp, MVM_UNICODE_PROPERTY_NFC_QC);
+    nfg_qc = MVM_unicode_codepoint_get_property_cstr(tc, cp, MVM_UNICODE_PROPERTY_NFG_QC);
+    return nfc_qc && nfc_qc[0] == 'Y' && nfg_qc && nfg_qc[0] == 'Y';
+}
+
+/* Fills in a block of the stable codepoint bitmap. Threads may race to do
+ * this, in which case all but the first to install the block throw theirs
+ * away; the contents are the same either way. */
+const MVMuint32 * MVM_unicode_normalizer_stable_block(MVMThreadContext *tc, MVMint32 block) {
+    MVMuint32 *bits = MVM_calloc(MVM_NORMALIZE_STABLE_BLOCK_SIZE / 32, sizeof(MVMuint32));
+    MVMuint32 *installed;
+    MVMint32 i;
+    for (i = 0; i < MVM_NORMALIZE_STABLE_BLOCK_SIZE; i++)
+        if (compute_stable(tc, block * MVM_NORMALIZE_STABLE_BLOCK_SIZE + i))
+            bits[i / 32] |= (MVMuint32)1 << (i % 32);
+    installed = MVM_casptr(&tc->instance->normalize_stable_blocks[block], NULL, bits);
+    if (installed) {
+        MVM_free(bits);
+        return installed;
+    }
+    return bits;
+}
+
 /* Returns 0 if the two graphemes should be combined and returns 1 or 2 if
  * the graphemes should break. 2 is returned if more than the currenly seen
  * graphemes may be needed to determine the breaking (this is only needed if
@@ -68,6 +68,55 @@ struct MVMNormalizer {
 /* Guts-y functions, called by the API level ones below. */
 MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVMNormalizer *n, MVMCodepoint in, MVMCodepoint *out);
 MVMint32 MVM_unicode_normalizer_process_codepoint_norm_terminator(MVMThreadContext *tc, MVMNormalizer *n, MVMCodepoint in, MVMCodepoint *out);
+const MVMuint32 * MVM_unicode_normalizer_stable_block(MVMThreadContext *tc, MVMint32 block);
+
+/* Number of codepoints covered by each block of the stable codepoint bitmap,
+ * and the number of blocks needed to cover all of Unicode. */
+#define MVM_NORMALIZE_STABLE_BLOCK_SIZE 256
+#define MVM_NORMALIZE_STABLE_BLOCKS     (0x110000 / MVM_NORMALIZE_STABLE_BLOCK_SIZE)
+
+/* Checks if a codepoint is stable under NFC and NFG: it passes the quick
+ * check for both, has a canonical combining class of zero, and is neither a
+ * control nor anything that may join a grapheme with its neighbours. Of two
+ * stable codepoints in a row, the first can be handed out as soon as the
+ * second is seen, since they can neither compose nor form a grapheme. The
+ * answer comes from a bitmap, one block of which is filled in from the
+ * property tables the first time a codepoint in it is asked about. */
+MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_is_stable(MVMThreadContext *tc, MVMCodepoint cp) {
+    const MVMuint32 *bits;
+    if (MVM_UNLIKELY(cp < 0 || 0x10FFFF < cp))
+        return 0;
+    bits = tc->instance->normalize_stable_blocks[cp / MVM_NORMALIZE_STABLE_BLOCK_SIZE];
+    if (MVM_UNLIKELY(!bits))
+        bits = MVM_unicode_normalizer_stable_block(tc, cp / MVM_NORMALIZE_STABLE_BLOCK_SIZE);
+    cp %= MVM_NORMALIZE_STABLE_BLOCK_SIZE;
+    return (bits[cp / 32] >> (cp % 32)) & 1;
+}
+
+/* Checks if the normalizer is in the state the composing fast paths leave it
+ * in: holding a single codepoint, which is either below the first significant
+ * codepoint and not \r, or (when not doing compatibility decomposition) is
+ * stable. In that state, a run of ASCII codepoints other than \r would each be
+ * handed straight back out one behind, so a caller may instead emit them
+ * itself, using MVM_unicode_normalizer_swap_held to exchange the held
+ * codepoint for the next to last codepoint of the run. The last must still go
+ * through the normalizer, since it may combine with whatever follows. */
+MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_holds_stable(MVMThreadContext *tc, MVMNormalizer *n) {
+    MVMCodepoint held;
+    if (!MVM_NORMALIZE_COMPOSE(n->form) || n->prepend_buffer
+            || n->buffer_end - n->buffer_start != 1)
+        return 0;
+    held = n->buffer[n->buffer_start];
+    if (held < n->first_significant)
+        return held != 0x0D;
+    return !MVM_NORMALIZE_COMPAT_DECOMP(n->form)
+        && MVM_unicode_normalizer_is_stable(tc, held);
+}
+MVM_STATIC_INLINE MVMCodepoint MVM_unicode_normalizer_swap_held(MVMThreadContext *tc, MVMNormalizer *n, MVMCodepoint in) {
+    MVMCodepoint out = n->buffer[n->buffer_start];
+    n->buffer[n->buffer_start] = in;
+    return out;
+}
 
 /* Takes a codepoint to process for normalization as the "in" parameter. If we
  * are able to produce one or more normalized codepoints right off, then we
@@ -121,6 +170,16 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint(MVMThreadCon
             }
         }
     }
+    /* A stable codepoint following a stable codepoint held by the composing
+     * normalizer is swapped for it, as the slow path would do after a good
+     * few property lookups. This keeps text in scripts that hardly ever
+     * compose, such as CJK or Cyrillic, off the slow path. */
+    if (!MVM_NORMALIZE_COMPAT_DECOMP(n->form)
+            && MVM_unicode_normalizer_holds_stable(tc, n)
+            && MVM_unicode_normalizer_is_stable(tc, in)) {
+        *out = MVM_unicode_normalizer_swap_held(tc, n, in);
+        return 1;
+    }
     /* Fall back to slow path. */
     return MVM_unicode_normalizer_process_codepoint_full(tc, n, in, out);
 }
@@ -475,6 +475,90 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     return result;
 }
 
+/* Number of graphemes a strand contributes to its string. */
+MVM_STATIC_INLINE MVMuint64 strand_graphs(const MVMStringStrand *strand) {
+    return (MVMuint64)(strand->end - strand->start) * (strand->repetitions + 1);
+}
+
+/* Replaces a number of adjacent strands of a strand string we are still
+ * building by a single strand over a flat copy of them. The caller must have
+ * rooted the string. */
+static void merge_strands(MVMThreadContext *tc, MVMString *s, MVMuint16 from, MVMuint16 count) {
+    MVMString *group, *flat;
+    MVMStringStrand *strands;
+    MVMuint64 graphs = 0;
+    MVMuint16 i;
+    MVMROOT(tc, s) {
+        group = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        group->body.storage_type = MVM_STRING_STRAND;
+        group->body.storage.strands = allocate_strands(tc, count);
+        group->body.num_strands = count;
+        copy_strands(tc, s, from, group, 0, count);
+        for (i = 0; i < count; i++)
+            graphs += strand_graphs(&(group->body.storage.strands[i]));
+        group->body.num_graphs = (MVMuint32)graphs;
+        flat = collapse_strands(tc, group);
+    }
+    strands = s->body.storage.strands;
+    strands[from].blob_string = flat;
+    MVM_gc_write_barrier(tc, (MVMCollectable *)s, (MVMCollectable *)flat);
+    strands[from].start       = 0;
+    strands[from].end         = flat->body.num_graphs;
+    strands[from].repetitions = 0;
+    move_strands(tc, s, from + count, s, from + 1, s->body.num_strands - from - count);
+    s->body.num_strands -= count - 1;
+}
+
+/* Produces a copy of a strand string with fewer strands, for when it has too
+ * many to be concatenated with another. Rather than collapsing the whole
+ * string, which makes building a large string by repeated appends quadratic,
+ * we first merge the trailing run of strands that are each no longer than
+ * those after them together (typically the pieces appended since we last
+ * got here), and then merge adjacent strands until their lengths, from the
+ * end, obey the run stack invariants of Timsort: each strand is longer than
+ * the one after it, and longer than the two after it together. Strand
+ * lengths then grow geometrically towards the start of the string, so there
+ * are logarithmically many of them, and each grapheme is copied a
+ * logarithmic number of times over the life of the string. */
+static MVMString * rebalance_strands(MVMThreadContext *tc, MVMString *orig) {
+    MVMString *result;
+    MVMROOT(tc, orig) {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    }
+    result->body.storage_type    = MVM_STRING_STRAND;
+    result->body.num_graphs      = orig->body.num_graphs;
+    result->body.num_strands     = orig->body.num_strands;
+    result->body.storage.strands = allocate_strands(tc, orig->body.num_strands);
+    copy_strands(tc, orig, 0, result, 0, orig->body.num_strands);
+
+    MVMROOT(tc, result) {
+        MVMStringStrand *strands = result->body.storage.strands;
+        MVMuint16 n = result->body.num_strands;
+        MVMuint16 from = n - 1;
+        MVMuint64 tail = strand_graphs(&strands[from]);
+        while (from > 0 && strand_graphs(&strands[from - 1]) <= tail)
+            tail += strand_graphs(&strands[--from]);
+        if (from < n - 1)
+            merge_strands(tc, result, from, n - from);
+
+        while ((n = result->body.num_strands) > 1) {
+            MVMuint64 last, second, third, fourth;
+            strands = result->body.storage.strands;
+            last    = strand_graphs(&strands[n - 1]);
+            second  = strand_graphs(&strands[n - 2]);
+            third   = n >= 3 ? strand_graphs(&strands[n - 3]) : 0;
+            fourth  = n >= 4 ? strand_graphs(&strands[n - 4]) : 0;
+            if ((n >= 3 && third <= second + last) || (n >= 4 && fourth <= third + second))
+                merge_strands(tc, result, third < last ? n - 3 : n - 2, 2);
+            else if (second <= last || n > MVM_STRING_MAX_STRANDS / 2)
+                merge_strands(tc, result, n - 2, 2);
+            else
+                break;
+        }
+    }
+    return result;
+}
+
 /* Takes a string that is no longer in NFG form after some concatenation-style
  * operation, and returns a new string that is in NFG. Note that we could do a
  * much, much, smarter thing in the future that doesn't involve all of this
@@ -642,6 +726,103 @@ static MVMint64 MVM_string_memmem_grapheme32str (MVMThreadContext *tc, MVMString
     rtrn = MVM_string_memmem_grapheme32(tc, Haystack->body.storage.blob_32, needle_buf ? needle_buf : needle->body.storage.blob_32, H_start, H_graphs, n_graphs);
     return rtrn;
 }
+/* Searches flat storage for a needle by first checking a block of candidate
+ * positions for a match of both the needle's first and last graphemes, which
+ * is written so the compiler can vectorize it, and only comparing the rest of
+ * the needle at positions that pass. This beats the two-way search of
+ * memmem_uint32 for the short needles that are most common, and lets us
+ * search 8-bit storage for a 32-bit needle and vice versa without widening
+ * or narrowing either. The needle must be at least 2 graphemes long, and the
+ * haystack no shorter than the needle. */
+#define MVM_STRING_SEARCH_BLOCK 16
+#define DEFINE_FIRST_LAST_SEARCH(name, H_type, n_type) \
+static MVMint64 name(const H_type *H, MVMStringIndex H_graphs, const n_type *n, \
+        MVMStringIndex n_graphs, MVMStringIndex start) { \
+    const MVMGrapheme32 first = n[0]; \
+    const MVMGrapheme32 last  = n[n_graphs - 1]; \
+    const H_type *H_last = H + n_graphs - 1; \
+    MVMStringIndex end = H_graphs - n_graphs + 1; \
+    MVMStringIndex i   = start; \
+    MVMStringIndex j, k; \
+    while (i + MVM_STRING_SEARCH_BLOCK <= end) { \
+        MVMuint32 mask = 0; \
+        MVM_VECTORIZE_LOOP \
+        for (k = 0; k < MVM_STRING_SEARCH_BLOCK; k++) \
+            mask |= (MVMuint32)((H[i + k] == first) & (H_last[i + k] == last)) << k; \
+        for (k = 0; mask; k++, mask >>= 1) { \
+            if (mask & 1) { \
+                for (j = 1; j < n_graphs - 1 && H[i + k + j] == n[j]; j++); \
+                if (j >= n_graphs - 1) \
+                    return i + k; \
+            } \
+        } \
+        i += MVM_STRING_SEARCH_BLOCK; \
+    } \
+    for (; i < end; i++) { \
+        if (H[i] == first && H_last[i] == last) { \
+            for (j = 1; j < n_graphs - 1 && H[i + j] == n[j]; j++); \
+            if (j >= n_graphs - 1) \
+                return i; \
+        } \
+    } \
+    return -1; \
+}
+DEFINE_FIRST_LAST_SEARCH(first_last_search_32_32, MVMGrapheme32, MVMGrapheme32)
+DEFINE_FIRST_LAST_SEARCH(first_last_search_32_8,  MVMGrapheme32, MVMGrapheme8)
+DEFINE_FIRST_LAST_SEARCH(first_last_search_8_32,  MVMGrapheme8,  MVMGrapheme32)
+#undef DEFINE_FIRST_LAST_SEARCH
+
+/* Needles longer than this are left to the memmem based searches below,
+ * since two-way search doesn't degrade on repetitive input like the first
+ * and last grapheme filter can. */
+#define MVM_STRING_FIRST_LAST_MAX_NEEDLE 256
+
+/* Gets a pointer to the graphemes of a flat string, and whether they are
+ * 8-bit ones, or NULL for strands. */
+static void * flat_graphemes(MVMString *s, MVMint32 *is_8bit) {
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32:
+            *is_8bit = 0;
+            return s->body.storage.blob_32;
+        case MVM_STRING_IN_SITU_32:
+            *is_8bit = 0;
+            return s->body.storage.in_situ_32;
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            *is_8bit = 1;
+            return s->body.storage.blob_8;
+        case MVM_STRING_IN_SITU_8:
+            *is_8bit = 1;
+            return s->body.storage.in_situ_8;
+        default:
+            return NULL;
+    }
+}
+
+/* Searches flat strings of mixed or 32-bit storage with the first and last
+ * grapheme filter. Returns -2 if the strings aren't suitable for it. */
+static MVMint64 flat_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle,
+        MVMint64 start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
+    MVMint32 H_8bit, n_8bit;
+    void *H = flat_graphemes(Haystack, &H_8bit);
+    void *n = flat_graphemes(needle, &n_8bit);
+    if (!H || !n || n_graphs < 2 || n_graphs > MVM_STRING_FIRST_LAST_MAX_NEEDLE)
+        return -2;
+    if (H_8bit) {
+        MVMStringIndex i;
+        if (n_8bit)
+            return -2; /* memmem does best here */
+        /* A needle that doesn't fit in 8 bits can't be in the haystack. */
+        for (i = 0; i < n_graphs; i++)
+            if (!can_fit_into_8bit(((MVMGrapheme32 *)n)[i]))
+                return -1;
+        return first_last_search_8_32(H, H_graphs, n, n_graphs, start);
+    }
+    if (n_8bit)
+        return first_last_search_32_8(H, H_graphs, n, n_graphs, start);
+    return first_last_search_32_32(H, H_graphs, n, n_graphs, start);
+}
+
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
     size_t index           = (size_t)start;
@@ -663,6 +844,14 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
     if (H_graphs < n_graphs)
         return -1;
 
+    /* Flat strings where either is 32-bit get the first and last grapheme
+     * filter search. */
+    {
+        MVMint64 flat_result = flat_string_index(tc, Haystack, needle, start, H_graphs, n_graphs);
+        if (flat_result != -2)
+            return flat_result;
+    }
+
     /* Fast paths when storage types are identical. Uses memmem function, which
      * uses Knuth-Morris-Pratt algorithm on Linux and on others
      * Crochemore+Perrin two-way string matching */
@@ -1058,10 +1247,19 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
             if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
                 MVMROOT(tc, result) {
                     if (strands_b <= strands_a) {
+                        /* This is most often a string being built up by
+                         * appending to it, so rebalance rather than collapse
+                         * it. Collapse b too if that didn't free enough. */
                         MVMROOT(tc, effective_b) {
-                            effective_a = collapse_strands(tc, effective_a);
+                            effective_a = rebalance_strands(tc, effective_a);
+                        }
+                        strands_a = effective_a->body.num_strands;
+                        if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
+                            MVMROOT(tc, effective_a) {
+                                effective_b = collapse_strands(tc, effective_b);
+                            }
+                            strands_b = 1;
                         }
-                        strands_a   = 1;
                     }
                     else {
                         MVMROOT(tc, effective_a) {
@@ -1337,6 +1535,64 @@ MVM_STATIC_INLINE MVMint64 string_equal_at_ignore_case_INTERNAL_loop(MVMThreadCo
      * to determine the length of the Haystack which was traversed, as it can
      * differ from the length of the needle if there are expansions. */
 }
+/* ASCII case mapping, for flat 8-bit strings with no synthetics in them. As
+ * those hold nothing above 127, the Unicode case mappings of what they hold
+ * are the ASCII ones, with no expansions, and the loops here are free of
+ * branches so that they vectorize. */
+MVM_STATIC_INLINE MVMGrapheme8 ascii_case_fold(MVMGrapheme8 g) {
+    return g | (((MVMuint8)(g - 'A') < 26) << 5);
+}
+static MVMint32 ascii_graphemes(const MVMGrapheme8 *g, MVMStringIndex length) {
+    MVMStringIndex i;
+    MVMuint8 high = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++)
+        high |= (MVMuint8)g[i];
+    return !(high & 0x80);
+}
+static MVMint32 ascii_needs_case_change(const MVMGrapheme8 *g, MVMStringIndex length, MVMint32 upper) {
+    MVMStringIndex i;
+    MVMuint8 from = upper ? 'a' : 'A';
+    MVMuint8 any = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++)
+        any |= (MVMuint8)(g[i] - from) < 26;
+    return any;
+}
+static void ascii_case_change(MVMGrapheme8 *out, const MVMGrapheme8 *in, MVMStringIndex length, MVMint32 upper) {
+    MVMStringIndex i;
+    MVMuint8 from = upper ? 'a' : 'A';
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++)
+        out[i] = in[i] ^ (((MVMuint8)(in[i] - from) < 26) << 5);
+}
+static MVMint32 ascii_equal_ignore_case(const MVMGrapheme8 *a, const MVMGrapheme8 *b, MVMStringIndex length) {
+    MVMStringIndex i;
+    MVMuint8 diff = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++)
+        diff |= ascii_case_fold(a[i]) ^ ascii_case_fold(b[i]);
+    return !diff;
+}
+
+/* Gets the graphemes of Haystack and needle if both are flat 8-bit strings,
+ * needle is ASCII and so are the H_length graphemes of Haystack from H_start,
+ * in which case comparing them ignoring case needs no case folded copy of
+ * needle; otherwise returns 0. The Haystack graphemes compared have to be
+ * checked too, as a synthetic's fold may expand to include ASCII (ß with a
+ * combining acute folds to an s followed by an ś). */
+static MVMint32 ascii_ignore_case_operands(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle,
+        MVMStringIndex H_start, MVMStringIndex H_length, MVMGrapheme8 **H, MVMGrapheme8 **n) {
+    MVMint32 H_8bit, n_8bit;
+    if (!needle || !IS_CONCRETE(needle))
+        return 0;
+    *H = flat_graphemes(Haystack, &H_8bit);
+    *n = flat_graphemes(needle, &n_8bit);
+    return *H && *n && H_8bit && n_8bit
+        && ascii_graphemes(*n, MVM_string_graphs_nocheck(tc, needle))
+        && ascii_graphemes(*H + H_start, H_length);
+}
+
 /* Checks if needle exists at the offset, but ignores case.
  * Sometimes there is a difference in length of a string before and after foldcase,
  * because of this we must compare this differently than just foldcasing both
@@ -1359,6 +1615,16 @@ static MVMint64 string_equal_at_ignore_case(MVMThreadContext *tc, MVMString *Hay
      * can't assume too much. If optimizing this be careful */
     if (H_graphs < H_offset)
         return 0;
+    if (ignorecase && !ignoremark) {
+        MVMGrapheme8 *H, *n;
+        MVMStringIndex n_graphs = needle && IS_CONCRETE(needle) ? MVM_string_graphs_nocheck(tc, needle) : 0;
+        MVMStringIndex H_rest   = H_graphs - H_offset;
+        if (ascii_ignore_case_operands(tc, Haystack, needle, H_offset,
+                n_graphs < H_rest ? n_graphs : H_rest, &H, &n)) {
+            return n_graphs <= H_rest
+                && ascii_equal_ignore_case(H + H_offset, n, n_graphs);
+        }
+    }
     MVMROOT(tc, Haystack) {
         needle_fc = ignorecase ? MVM_string_fc(tc, needle) : needle;
     }
@@ -1482,6 +1748,18 @@ static MVMint64 string_index_ignore_case(MVMThreadContext *tc, MVMString *Haysta
     if (H_graphs * 3 < n_graphs)
         return -1;
 
+    if (ignorecase && !ignoremark) {
+        MVMGrapheme8 *H, *n;
+        if (ascii_ignore_case_operands(tc, Haystack, needle, index, H_graphs - index, &H, &n)) {
+            MVMGrapheme8 first = ascii_case_fold(n[0]);
+            for (; index + n_graphs <= H_graphs; index++)
+                if (ascii_case_fold(H[index]) == first
+                        && ascii_equal_ignore_case(H + index, n, n_graphs))
+                    return index;
+            return -1;
+        }
+    }
+
     MVMROOT(tc, Haystack) {
         needle_fc = ignorecase ? MVM_string_fc(tc, needle) : needle;
     }
@@ -1631,6 +1909,33 @@ static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 t
     if (sgraphs) {
         MVMString *result;
         MVMGraphemeIter gi;
+        MVMint32 is_8bit;
+        MVMGrapheme8 *g8 = flat_graphemes(s, &is_8bit);
+
+        /* Flat 8-bit ASCII strings are changed in one go, and stay 8-bit. */
+        if (g8 && is_8bit && ascii_graphemes(g8, sgraphs)) {
+            MVMint32 upper = type == MVM_unicode_case_change_type_upper
+                          || type == MVM_unicode_case_change_type_title;
+            MVMGrapheme8 *result_g8;
+            if (!ascii_needs_case_change(g8, sgraphs, upper))
+                return s;
+            MVMROOT(tc, s) {
+                result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+            }
+            if (sgraphs <= 8) {
+                result->body.storage_type = MVM_STRING_IN_SITU_8;
+                result_g8 = result->body.storage.in_situ_8;
+            }
+            else {
+                result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+                result->body.storage.blob_8 = MVM_malloc(sgraphs * sizeof(MVMGrapheme8));
+                result_g8 = result->body.storage.blob_8;
+            }
+            result->body.num_graphs = sgraphs;
+            ascii_case_change(result_g8, flat_graphemes(s, &is_8bit), sgraphs, upper);
+            return result;
+        }
+
         MVMint64 result_graphs = sgraphs;
         MVMGrapheme32 *result_buf = MVM_malloc(result_graphs * sizeof(MVMGrapheme32));
         MVMint32 changed = 0;
@@ -1681,6 +1986,19 @@ static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 t
                         break;
                 }
             }
+            else if (0 <= g && g < 0x80) {
+                /* ASCII maps to ASCII, without needing a property lookup. */
+                MVMGrapheme32 changed_g = g;
+                if (type == MVM_unicode_case_change_type_upper || type == MVM_unicode_case_change_type_title) {
+                    if ('a' <= g && g <= 'z')
+                        changed_g = g - 0x20;
+                }
+                else if ('A' <= g && g <= 'Z') {
+                    changed_g = g + 0x20;
+                }
+                changed |= changed_g != g;
+                result_buf[i++] = changed_g;
+            }
             else if (0 <= g) {
                 const MVMCodepoint *result_cps;
                 MVMuint32 num_result_cps = MVM_unicode_get_case_change(tc,
@@ -2731,15 +3049,9 @@ MVMString * MVM_string_bitxor(MVMThreadContext *tc, MVMString *a, MVMString *b)
 #define UPV_Po MVM_UNICODE_PVALUE_GC_PO
 
 #include "strings/unicode_prop_macros.h"
-/* Checks if the specified grapheme is in the given character class. */
-MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g) {
-    /* If it's a synthetic, then grab the base codepoint. */
-    MVMCodepoint cp;
-    if (0 <= g)
-        cp = (MVMCodepoint)g;
-    else
-        cp = MVM_nfg_get_synthetic_info(tc, g)->codes[0];
-
+/* Checks if the specified codepoint is in the given character class, going
+ * to the Unicode property tables where need be. */
+static MVMint64 codepoint_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMCodepoint cp) {
     switch (cclass) {
         case MVM_CCLASS_ANY:
             return 1;
@@ -2825,6 +3137,39 @@ MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MV
     }
 }
 
+/* The character classes each codepoint in the Latin-1 range is in, as a mask
+ * of MVM_CCLASS_* bits. These are the codepoints the vast majority of cclass
+ * checks are made on, so answering those from here spares going through the
+ * property tables. It is filled in at startup by asking the property tables,
+ * so always agrees with them. */
+static MVMuint16 latin1_cclasses[256];
+
+void MVM_string_cclass_init(MVMThreadContext *tc) {
+    MVMCodepoint cp;
+    for (cp = 0; cp < 256; cp++) {
+        MVMuint16 mask = 0;
+        MVMuint16 cclass;
+        for (cclass = 1; cclass <= MVM_CCLASS_WORD; cclass <<= 1)
+            if (codepoint_is_cclass(tc, cclass, cp))
+                mask |= cclass;
+        latin1_cclasses[cp] = mask;
+    }
+}
+
+/* Checks if the specified grapheme is in the given character class. */
+MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g) {
+    /* Latin-1 codepoints are looked up in the table above, provided we were
+     * asked about a single class (MVM_CCLASS_ANY is the only valid class that
+     * is not). */
+    if (0 <= g && g < 256 && (cclass & (cclass - 1)) == 0)
+        return (latin1_cclasses[g] & cclass) != 0;
+
+    /* If it's a synthetic, then grab the base codepoint. */
+    return codepoint_is_cclass(tc, cclass, 0 <= g
+        ? (MVMCodepoint)g
+        : MVM_nfg_get_synthetic_info(tc, g)->codes[0]);
+}
+
 /* Checks if the character at the specified offset is a member of the
  * indicated character class. */
 MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset) {
@@ -140,6 +140,7 @@ MVMint64 MVM_string_find_not_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMSt
 MVMuint8 MVM_string_find_encoding(MVMThreadContext *tc, MVMString *name);
 MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp);
 MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
+void MVM_string_cclass_init(MVMThreadContext *tc);
 MVMString * MVM_string_ascii_from_buf_nocheck(MVMThreadContext *tc, MVMGrapheme8 *buf, MVMStringIndex len);
 char * MVM_string_encoding_cname(MVMThreadContext *tc, MVMint64 encoding);
 /* If MVM_DEBUG_NFG is 1, calls to NFG_CHECK will re_nfg the given string
@@ -675,6 +675,244 @@ MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMStrin
     return collation_return_by_quaternary(tc, &level_eval_settings, alen, blen, compare_by_cp_rtrn);
 }
 
+/* Sort keys. A sort key is a string of bytes made so that a string being
+ * compared many times (as when sorting) only has its collation elements worked
+ * out once. The key is made of the weights of each enabled level in turn, with
+ * ignorable weights left out and each level terminated by a zero weight,
+ * followed by the codepoints if the quaternary level is enabled. Weights of a
+ * reversed level have all their bits flipped.
+ *
+ * Comparing two keys with memcmp (and then by length) orders them as
+ * MVM_unicode_string_compare orders their strings provided the primary and
+ * secondary levels are each enabled in exactly one direction; see
+ * sort_key_orders_like_compare. The only exception is that with the
+ * quaternary level disabled the comparison finds the empty string equal to
+ * every other one, which is no ordering at all, and its key sorts first. */
+typedef struct {
+    MVMuint8 *bytes;
+    size_t    used;
+    size_t    alloc;
+} sort_key;
+static void sort_key_push(sort_key *key, MVMuint8 *bytes, size_t num_bytes, MVMint32 reversed) {
+    size_t i;
+    if (key->alloc < key->used + num_bytes) {
+        key->alloc = 2 * key->alloc + num_bytes;
+        key->bytes = MVM_realloc(key->bytes, key->alloc);
+    }
+    for (i = 0; i < num_bytes; i++)
+        key->bytes[key->used++] = reversed ? ~bytes[i] : bytes[i];
+}
+/* Weights below 0xFF00 take two bytes and the rest three, starting with
+ * 0xFF. As no encoding is a prefix of another, flipping the bits of each
+ * reverses the order they sort in. */
+static void sort_key_push_weight(sort_key *key, MVMuint32 weight, MVMint32 reversed) {
+    MVMuint8 bytes[3];
+    if (weight < 0xFF00) {
+        bytes[0] = weight >> 8;
+        bytes[1] = weight & 0xFF;
+        sort_key_push(key, bytes, 2, reversed);
+    }
+    else {
+        weight -= 0xFF00;
+        bytes[0] = 0xFF;
+        bytes[1] = weight >> 8;
+        bytes[2] = weight & 0xFF;
+        sort_key_push(key, bytes, 3, reversed);
+    }
+}
+static void sort_key_push_codepoint(sort_key *key, MVMuint32 cp, MVMint32 reversed) {
+    MVMuint8 bytes[3];
+    bytes[0] = cp >> 16;
+    bytes[1] = (cp >> 8) & 0xFF;
+    bytes[2] = cp & 0xFF;
+    sort_key_push(key, bytes, 3, reversed);
+}
+static void compute_sort_key(MVMThreadContext *tc, MVMString *s, MVMint64 collation_mode, sort_key *key) {
+    MVMCodepointIter ci;
+    collation_stack stack;
+    MVMint64 level, i;
+    MVMint64 quaternary_negative = (collation_mode & MVM_COLLATION_QUATERNARY_NEGATIVE)
+        && !(collation_mode & MVM_COLLATION_QUATERNARY_POSITIVE);
+    key->used = 0;
+
+    /* MVM_unicode_string_compare orders the empty string against any other
+     * by length on the quaternary level. The empty key sorts first already;
+     * for a reversed quaternary level all keys get a leading byte, with that
+     * of the empty string sorting last. */
+    if (quaternary_negative) {
+        MVMuint8 empty = MVM_string_graphs_nocheck(tc, s) == 0;
+        sort_key_push(key, &empty, 1, 0);
+    }
+    if (MVM_string_graphs_nocheck(tc, s) == 0)
+        return;
+
+    init_stack(tc, &stack);
+    MVM_string_ci_init(tc, &ci, s, 0, 0);
+    while (grab_from_stack(tc, &ci, &stack, "a"))
+        ;
+    for (level = 0; level < 3; level++) {
+        MVMint64 positive = collation_mode & (MVM_COLLATION_PRIMARY_POSITIVE << (2 * level));
+        MVMint64 negative = collation_mode & (MVM_COLLATION_PRIMARY_NEGATIVE << (2 * level));
+        /* Both directions enabled cancel out, as they do in the comparison. */
+        if (!positive == !negative)
+            continue;
+        for (i = 0; i <= stack.stack_top; i++)
+            if (stack.keys[i].a[level] != collation_zero)
+                sort_key_push_weight(key, stack.keys[i].a[level], !!negative);
+        sort_key_push_weight(key, 0, !!negative);
+    }
+    cleanup_stack(tc, &stack);
+
+    /* Ties are broken by codepoint, then by length; a terminator below any
+     * codepoint makes the shorter of two strings that agree so far first. */
+    {
+        MVMint64 positive = collation_mode & MVM_COLLATION_QUATERNARY_POSITIVE;
+        MVMint64 negative = collation_mode & MVM_COLLATION_QUATERNARY_NEGATIVE;
+        if (!positive != !negative) {
+            MVM_string_ci_init(tc, &ci, s, 0, 0);
+            while (MVM_string_ci_has_more(tc, &ci))
+                sort_key_push_codepoint(key, MVM_string_ci_get_codepoint(tc, &ci) + 1, !!negative);
+            sort_key_push_codepoint(key, 0, !!negative);
+        }
+    }
+}
+/* MVM_unicode_string_compare walks the weights of every level, including
+ * those it makes no decision on. When the primary or secondary level is
+ * disabled (or enabled in both directions) the walk over it can get out of
+ * step between the two strings, and the order that results is not one a key
+ * can reproduce. */
+static MVMint64 sort_key_orders_like_compare(MVMint64 collation_mode) {
+    MVMint64 level;
+    for (level = 0; level < 2; level++) {
+        MVMint64 positive = collation_mode & (MVM_COLLATION_PRIMARY_POSITIVE << (2 * level));
+        MVMint64 negative = collation_mode & (MVM_COLLATION_PRIMARY_NEGATIVE << (2 * level));
+        if (!positive == !negative)
+            return 0;
+    }
+    return 1;
+}
+
+/* Computes the sort key of a string under the given collation mode (see the
+ * top of this file), replacing the contents of buf, which must be a native
+ * array of 8-bit integers, with it. Returns buf. Keys only order strings as
+ * they compare under the modes sort_key_orders_like_compare accepts. */
+MVMObject * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s, MVMint64 collation_mode,
+        MVMint64 lang_mode, MVMint64 country_mode, MVMObject *buf) {
+    MVMArrayREPRData *buf_rd;
+    sort_key key = { NULL, 0, 0 };
+    MVM_string_check_arg(tc, s, "collation key");
+    if (!IS_CONCRETE(buf) || REPR(buf)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "collation key requires a native array to write into");
+    buf_rd = (MVMArrayREPRData *)STABLE(buf)->REPR_data;
+    if (!buf_rd || (buf_rd->slot_type != MVM_ARRAY_U8 && buf_rd->slot_type != MVM_ARRAY_I8))
+        MVM_exception_throw_adhoc(tc, "collation key requires a native array of 8-bit integers");
+
+    compute_sort_key(tc, s, collation_mode, &key);
+    MVMROOT(tc, buf) {
+        MVM_repr_pos_set_elems(tc, buf, key.used);
+    }
+    if (key.used)
+        memcpy(((MVMArray *)buf)->body.slots.u8 + ((MVMArray *)buf)->body.start, key.bytes, key.used);
+    MVM_free(key.bytes);
+    return buf;
+}
+
+/* A string being sorted, with its key and original position. */
+typedef struct {
+    MVMuint8  *key;
+    size_t     key_length;
+    MVMString *s;
+    MVMint64   index;
+} collation_sort_entry;
+static int compare_collation_sort_entries(const void *a_in, const void *b_in) {
+    const collation_sort_entry *a = (const collation_sort_entry *)a_in;
+    const collation_sort_entry *b = (const collation_sort_entry *)b_in;
+    size_t common = a->key_length < b->key_length ? a->key_length : b->key_length;
+    int result = common ? memcmp(a->key, b->key, common) : 0;
+    if (result)
+        return result;
+    if (a->key_length != b->key_length)
+        return a->key_length < b->key_length ? -1 : 1;
+    return a->index < b->index ? -1 : a->index > b->index ? 1 : 0;
+}
+/* Sorts entries[0..elems) with MVM_unicode_string_compare, for collation
+ * modes keys can't be used for. A merge sort, so as to be stable. */
+static void collation_merge_sort(MVMThreadContext *tc, collation_sort_entry *entries,
+        collation_sort_entry *scratch, MVMint64 elems, MVMint64 collation_mode,
+        MVMint64 lang_mode, MVMint64 country_mode) {
+    MVMint64 half = elems / 2, i = 0, j = half, k = 0;
+    if (elems < 2)
+        return;
+    collation_merge_sort(tc, entries, scratch, half, collation_mode, lang_mode, country_mode);
+    collation_merge_sort(tc, entries + half, scratch, elems - half, collation_mode, lang_mode, country_mode);
+    while (i < half && j < elems)
+        scratch[k++] = MVM_unicode_string_compare(tc, entries[j].s, entries[i].s,
+                collation_mode, lang_mode, country_mode) < 0 ? entries[j++] : entries[i++];
+    while (i < half)
+        scratch[k++] = entries[i++];
+    memcpy(entries, scratch, k * sizeof(collation_sort_entry));
+}
+/* Sorts a native array of strings in place by the Unicode Collation
+ * Algorithm, computing a sort key for each string once rather than
+ * collation elements for both strings on each comparison. Strings that
+ * compare as equal stay in their original order. */
+void MVM_unicode_string_collation_sort(MVMThreadContext *tc, MVMObject *array, MVMint64 collation_mode,
+        MVMint64 lang_mode, MVMint64 country_mode) {
+    MVMArrayBody *body;
+    MVMArrayREPRData *array_rd;
+    collation_sort_entry *entries;
+    sort_key key = { NULL, 0, 0 };
+    MVMint64 elems, i;
+    if (!IS_CONCRETE(array) || REPR(array)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "collation sort requires a native array of strings");
+    array_rd = (MVMArrayREPRData *)STABLE(array)->REPR_data;
+    if (!array_rd || array_rd->slot_type != MVM_ARRAY_STR)
+        MVM_exception_throw_adhoc(tc, "collation sort requires a native array of strings");
+    body  = &((MVMArray *)array)->body;
+    elems = body->elems;
+    if (elems < 2)
+        return;
+
+    for (i = 0; i < elems; i++)
+        MVM_string_check_arg(tc, body->slots.s[body->start + i], "collation sort");
+
+    /* Nothing in here allocates GC-managed memory, so the strings can be
+     * held on to unrooted. */
+    entries = MVM_malloc(elems * sizeof(collation_sort_entry));
+    for (i = 0; i < elems; i++) {
+        entries[i].key        = NULL;
+        entries[i].key_length = 0;
+        entries[i].s          = body->slots.s[body->start + i];
+        entries[i].index      = i;
+    }
+
+    if (sort_key_orders_like_compare(collation_mode)) {
+        /* Each key is copied out of a buffer shared by all of them. */
+        for (i = 0; i < elems; i++) {
+            compute_sort_key(tc, entries[i].s, collation_mode, &key);
+            entries[i].key        = MVM_malloc(key.used ? key.used : 1);
+            entries[i].key_length = key.used;
+            if (key.used)
+                memcpy(entries[i].key, key.bytes, key.used);
+        }
+        MVM_free(key.bytes);
+        qsort(entries, elems, sizeof(collation_sort_entry), compare_collation_sort_entries);
+    }
+    else {
+        collation_sort_entry *scratch = MVM_malloc(elems * sizeof(collation_sort_entry));
+        collation_merge_sort(tc, entries, scratch, elems, collation_mode, lang_mode, country_mode);
+        MVM_free(scratch);
+    }
+
+    /* The strings are only being moved around within the array, which
+     * already references all of them, so no write barrier is needed. */
+    for (i = 0; i < elems; i++) {
+        body->slots.s[body->start + i] = entries[i].s;
+        MVM_free(entries[i].key);
+    }
+    MVM_free(entries);
+}
+
 /* Looks up a codepoint by name. Lazily constructs a hash. */
 MVMGrapheme32 MVM_unicode_lookup_by_name(MVMThreadContext *tc, MVMString *name) {
     char *cname = MVM_string_utf8_encode_C_string(tc, name);
@@ -950,6 +1188,8 @@ void MVM_unicode_init(MVMThreadContext *tc) {
         }
     }
     tc->instance->unicode_property_values_hashes = hash_array;
+    tc->instance->normalize_stable_blocks = MVM_calloc(MVM_NORMALIZE_STABLE_BLOCKS, sizeof(MVMuint32 *));
+    MVM_string_cclass_init(tc);
 }
 static MVMint32 unicode_cname_to_property_value_code(MVMThreadContext *tc, MVMint64 property_code, const char *cname, MVMuint64 cname_length) {
     char *out_str = NULL;
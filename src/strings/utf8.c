@@ -245,17 +245,66 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     MVMint32 count = 0;
     MVMCodepoint codepoint;
     MVMint32 state = 0;
-    MVMint32 bufsize = bytes;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMint32 bufsize;
+    MVMGrapheme32 *buffer;
     size_t orig_bytes = bytes;
     const char *orig_utf8 = utf8;
     MVMint32 ready;
+    MVMNormalizer norm;
+
+    /* Input that is entirely ASCII (minus \r) is already in NFG, so we can
+     * copy it straight into 8-bit storage. This is common enough, in source
+     * code, JSON and the like, to be worth the scan. */
+    size_t run = MVM_string_ascii_run_length((const MVMuint8 *)utf8, bytes);
+    if (run == bytes) {
+        MVMGrapheme8 *storage;
+        if (bytes <= 8) {
+            storage = result->body.storage.in_situ_8;
+            result->body.storage_type = MVM_STRING_IN_SITU_8;
+        }
+        else {
+            storage = result->body.storage.blob_8 = MVM_malloc(bytes);
+            result->body.storage_type = MVM_STRING_GRAPHEME_8;
+        }
+        memcpy(storage, utf8, bytes);
+        result->body.num_graphs = bytes;
+        return result;
+    }
+
+    bufsize = bytes;
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+
+    /* Otherwise, all but the last byte of the leading ASCII run can be taken
+     * as is; the last may combine with what follows. */
+    if (run > 1) {
+        MVM_VECTORIZE_LOOP
+        for (ready = 0; ready < (MVMint32)run - 1; ready++)
+            buffer[ready] = (MVMuint8)utf8[ready];
+        count  = run - 1;
+        utf8  += run - 1;
+        bytes -= run - 1;
+    }
 
     /* Need to normalize to NFG as we decode. */
-    MVMNormalizer norm;
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
     for (; bytes; ++utf8, --bytes) {
+        /* If we're between codepoints and have another ASCII run ahead of
+         * us, then skip the decoder and normalizer for all but the last byte
+         * of it, provided the normalizer would just hand them back anyway. */
+        if (state == UTF8_ACCEPT && (MVMuint8)*utf8 < 0x80 && bytes > 1
+                && MVM_unicode_normalizer_holds_stable(tc, &norm)) {
+            run = MVM_string_ascii_run_length((const MVMuint8 *)utf8, bytes);
+            if (run > 1) {
+                size_t i;
+                buffer[count++] = MVM_unicode_normalizer_swap_held(tc, &norm,
+                    (MVMuint8)utf8[run - 2]);
+                for (i = 0; i < run - 2; i++)
+                    buffer[count++] = (MVMuint8)utf8[i];
+                utf8  += run - 1;
+                bytes -= run - 1;
+            }
+        }
         switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8), UTF8_ACCEPT)) {
         case UTF8_ACCEPT: { /* got a codepoint */
             MVMGrapheme32 g;
@@ -420,6 +469,45 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                /* Runs of ASCII other than \r need neither the decoder nor the
+                 * normalizer. After the lagging codepoint, all but the last
+                 * byte of the run go straight into the buffer, up to any
+                 * separator or the stopper; the byte after those becomes
+                 * the lagging codepoint. */
+                if (state == UTF8_ACCEPT && bytes[pos] < 0x80) {
+                    MVMint32 end = pos + MVM_string_ascii_run_length(bytes + pos, cur_bytes->length - pos);
+                    if (end > pos) {
+                        while (pos < end) {
+                            if (count == bufsize) {
+                                MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                                count = 0;
+                            }
+                            buffer[count++] = lag_codepoint;
+                            total++;
+                            if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                    (stopper_chars && *stopper_chars == total)) {
+                                reached_stopper = 1;
+                                last_accept_bytes = lag_last_accept_bytes;
+                                last_accept_pos = lag_last_accept_pos;
+                                goto done;
+                            }
+                            pos += MVM_string_decodestream_append_run(tc, ds, seps,
+                                stopper_chars, bytes + pos, end - pos - 1, &buffer,
+                                &count, bufsize, &total);
+                            if (stopper_chars && *stopper_chars == total) {
+                                reached_stopper = 1;
+                                last_accept_bytes = cur_bytes;
+                                last_accept_pos = pos;
+                                goto done;
+                            }
+                            lag_codepoint = bytes[pos++];
+                            lag_last_accept_bytes = cur_bytes;
+                            lag_last_accept_pos = pos;
+                        }
+                        continue;
+                    }
+                }
                 switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, bytes[pos++]), UTF8_ACCEPT)) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -541,6 +629,56 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
     return reached_stopper;
 }
 
+/* Makes sure there's room for another needed bytes in the result, plus the
+ * 4 bytes breathing space we always keep. */
+MVM_STATIC_INLINE void ensure_result_space(MVMuint8 **result, size_t result_pos,
+        size_t *result_limit, size_t needed) {
+    if (result_pos + needed > *result_limit) {
+        *result_limit *= 2;
+        if (*result_limit < result_pos + needed)
+            *result_limit = result_pos + needed;
+        *result = MVM_realloc(*result, *result_limit + 4);
+    }
+}
+
+/* Appends the UTF-8 encoding of a codepoint to the result, or else the
+ * replacement if there is one. Returns zero if the codepoint can't be encoded
+ * and there is no replacement. */
+static MVMint32 append_codepoint(MVMuint8 **result, size_t *result_pos,
+        size_t *result_limit, MVMCodepoint cp, const MVMuint8 *repl_bytes,
+        MVMuint64 repl_length) {
+    MVMint32 bytes;
+    ensure_result_space(result, *result_pos, result_limit, 1);
+    bytes = utf8_encode(*result + *result_pos, cp);
+    if (bytes) {
+        *result_pos += bytes;
+        return 1;
+    }
+    if (repl_bytes) {
+        ensure_result_space(result, *result_pos, result_limit, repl_length);
+        memcpy(*result + *result_pos, repl_bytes, repl_length);
+        *result_pos += repl_length;
+        return 1;
+    }
+    return 0;
+}
+
+/* Counts the leading graphemes of a 8-bit buffer that are not synthetics,
+ * and so are ASCII, a word at a time. */
+static size_t ascii_grapheme8_run_length(const MVMGrapheme8 *graphs, size_t len) {
+    size_t i = 0;
+    while (i + 8 <= len) {
+        MVMuint64 word;
+        memcpy(&word, graphs + i, 8);
+        if (word & 0x8080808080808080ULL)
+            break;
+        i += 8;
+    }
+    while (i < len && graphs[i] >= 0)
+        i++;
+    return i;
+}
+
 /* Encodes the specified string to UTF-8. */
 char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
         MVMString *str, MVMuint64 *output_size, MVMint64 start, MVMint64 length,
@@ -551,6 +689,8 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     MVMStringIndex   strgraphs  = MVM_string_graphs(tc, str);
     MVMuint8        *repl_bytes = NULL;
     MVMuint64        repl_length;
+    MVMuint16        storage_type = str->body.storage_type;
+    MVMCodepoint     cp;
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start (%"PRId64") out of range (0..%"PRIu32")", start, strgraphs);
@@ -559,6 +699,19 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length (%"PRId64") out of range (0..%"PRIu32")", length, strgraphs);
 
+    /* Flat ASCII storage is already UTF-8, unless on Windows we have to turn
+     * \n into \r\n, which we leave to the iterator as below. */
+#ifdef _WIN32
+    if (!translate_newlines)
+#endif
+    if (storage_type == MVM_STRING_GRAPHEME_ASCII) {
+        result = MVM_malloc(length + 4);
+        memcpy(result, str->body.storage.blob_ascii + start, length);
+        if (output_size)
+            *output_size = (MVMuint64)length;
+        return (char *)result;
+    }
+
     if (replacement)
         repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
             replacement, &repl_length, 0, -1, NULL, translate_newlines);
@@ -569,37 +722,97 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     result       = MVM_malloc(result_limit + 4);
     result_pos   = 0;
 
-    /* Iterate the codepoints and encode them. */
-    MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
-    while (MVM_string_ci_has_more(tc, &ci)) {
-        MVMint32 bytes;
-        MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
-        if (result_pos >= result_limit) {
-            result_limit *= 2;
-            result = MVM_realloc(result, result_limit + 4);
-        }
-        bytes = utf8_encode(result + result_pos, cp);
-        if (bytes)
-            result_pos += bytes;
-        else if (replacement) {
-            if (repl_length >= result_limit || result_pos >= result_limit - repl_length) {
-                result_limit += repl_length;
-                result = MVM_realloc(result, result_limit + 4);
+    /* Other flat storage can be encoded straight from the buffer, copying
+     * ASCII in bulk and only looking up synthetics when we meet them. On
+     * Windows, we may have to turn \n into \r\n, so leave that to the
+     * iterator. */
+#ifdef _WIN32
+    if (!translate_newlines)
+#endif
+    if (storage_type == MVM_STRING_GRAPHEME_8 || storage_type == MVM_STRING_IN_SITU_8) {
+        const MVMGrapheme8 *graphs = (storage_type == MVM_STRING_GRAPHEME_8
+            ? str->body.storage.blob_8
+            : str->body.storage.in_situ_8) + start;
+        size_t i = 0;
+        while (i < (size_t)length) {
+            size_t run = ascii_grapheme8_run_length(graphs + i, length - i);
+            if (run) {
+                ensure_result_space(&result, result_pos, &result_limit, run);
+                memcpy(result + result_pos, graphs + i, run);
+                result_pos += run;
+                i += run;
+            }
+            else {
+                MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, graphs[i++]);
+                MVMint32 j;
+                for (j = 0; j < synth->num_codes; j++) {
+                    cp = synth->codes[j];
+                    if (!append_codepoint(&result, &result_pos, &result_limit, cp, repl_bytes, repl_length))
+                        goto error;
+                }
             }
-            memcpy(result + result_pos, repl_bytes, repl_length);
-            result_pos += repl_length;
         }
-        else {
-            MVM_free(result);
-            MVM_free(repl_bytes);
-            MVM_string_utf8_throw_encoding_exception(tc, cp);
+        goto done;
+    }
+    else if (storage_type == MVM_STRING_GRAPHEME_32 || storage_type == MVM_STRING_IN_SITU_32) {
+        const MVMGrapheme32 *graphs = (storage_type == MVM_STRING_GRAPHEME_32
+            ? str->body.storage.blob_32
+            : str->body.storage.in_situ_32) + start;
+        size_t i = 0;
+        while (i < (size_t)length) {
+            MVMGrapheme32 g;
+
+            /* Take ASCII four graphemes at a time; negative synthetics will
+             * have the high bits set too. */
+            while (i + 4 <= (size_t)length
+                    && !((graphs[i] | graphs[i + 1] | graphs[i + 2] | graphs[i + 3]) & ~0x7F)) {
+                ensure_result_space(&result, result_pos, &result_limit, 4);
+                result[result_pos++] = (MVMuint8)graphs[i++];
+                result[result_pos++] = (MVMuint8)graphs[i++];
+                result[result_pos++] = (MVMuint8)graphs[i++];
+                result[result_pos++] = (MVMuint8)graphs[i++];
+            }
+            if (i == (size_t)length)
+                break;
+
+            g = graphs[i++];
+            if (g >= 0) {
+                cp = g;
+                if (!append_codepoint(&result, &result_pos, &result_limit, cp, repl_bytes, repl_length))
+                    goto error;
+            }
+            else {
+                MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+                MVMint32 j;
+                for (j = 0; j < synth->num_codes; j++) {
+                    cp = synth->codes[j];
+                    if (!append_codepoint(&result, &result_pos, &result_limit, cp, repl_bytes, repl_length))
+                        goto error;
+                }
+            }
         }
+        goto done;
     }
 
+    /* Otherwise, iterate the codepoints and encode them. */
+    MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+    while (MVM_string_ci_has_more(tc, &ci)) {
+        cp = MVM_string_ci_get_codepoint(tc, &ci);
+        if (!append_codepoint(&result, &result_pos, &result_limit, cp, repl_bytes, repl_length))
+            goto error;
+    }
+
+  done:
     if (output_size)
         *output_size = (MVMuint64)result_pos;
     MVM_free(repl_bytes);
     return (char *)result;
+
+  error:
+    MVM_free(result);
+    MVM_free(repl_bytes);
+    MVM_string_utf8_throw_encoding_exception(tc, cp);
+    return NULL;
 }
 
 /* Encodes the specified string to UTF-8. */
@@ -87,8 +87,8 @@ typedef struct MVMNFABody MVMNFABody;
 typedef struct MVMNFAStateInfo MVMNFAStateInfo;
 typedef struct MVMNFGState MVMNFGState;
 typedef struct MVMNFGSynthetic MVMNFGSynthetic;
-typedef struct MVMNFGTrieNode MVMNFGTrieNode;
-typedef struct MVMNFGTrieNodeEntry MVMNFGTrieNodeEntry;
+typedef struct MVMNFGLookupTable MVMNFGLookupTable;
+typedef struct MVMNFGLookupEntry MVMNFGLookupEntry;
 typedef struct MVMNativeCall MVMNativeCall;
 typedef struct MVMNativeCallBody MVMNativeCallBody;
 typedef struct MVMNativeRef MVMNativeRef;
@@ -268,6 +268,9 @@ typedef struct MVMJitDispatch MVMJitDispatch;
 typedef struct MVMJitIsType MVMJitIsType;
 typedef struct MVMJitCode MVMJitCode;
 typedef struct MVMJitCompiler MVMJitCompiler;
+typedef struct MVMJitCodeHeap MVMJitCodeHeap;
+typedef struct MVMJitCodeHeapRegion MVMJitCodeHeapRegion;
+typedef struct MVMJitCodeHeapFree MVMJitCodeHeapFree;
 typedef struct MVMJitExprTree MVMJitExprTree;
 typedef struct MVMJitExprInfo MVMJitExprInfo;
 typedef struct MVMJitExprTemplate MVMJitExprTemplate;
@@ -307,9 +310,14 @@ typedef struct MVMFixKeyHashTable MVMFixKeyHashTable;
 typedef struct MVMIndexHashTable MVMIndexHashTable;
 typedef struct MVMPtrHashTable MVMPtrHashTable;
 typedef struct MVMUniHashTable MVMUniHashTable;
+typedef struct MVMIntHashTable MVMIntHashTable;
 typedef struct MVMDispDefinition MVMDispDefinition;
 typedef struct MVMDispRegistry MVMDispRegistry;
 typedef struct MVMDispRegistryTable MVMDispRegistryTable;
+typedef struct MVMDispMegamorphicCache MVMDispMegamorphicCache;
+typedef struct MVMDispMegamorphicEntry MVMDispMegamorphicEntry;
+typedef struct MVMDispStats MVMDispStats;
+typedef struct MVMDispStatsSite MVMDispStatsSite;
 typedef struct MVMDispInlineCache MVMDispInlineCache;
 typedef struct MVMDispInlineCacheEntry MVMDispInlineCacheEntry;
 typedef struct MVMDispInlineCacheEntryResolvedGetLexStatic MVMDispInlineCacheEntryResolvedGetLexStatic;
@@ -336,3 +344,12 @@ typedef struct MVMTracked MVMTracked;
 typedef struct MVMTrackedBody MVMTrackedBody;
 typedef struct MVMStat MVMStat;
 typedef struct MVMStatBody MVMStatBody;
+typedef struct MVMStringBuilder MVMStringBuilder;
+typedef struct MVMStringBuilderBody MVMStringBuilderBody;
+typedef struct MVMConcHash MVMConcHash;
+typedef struct MVMConcHashBody MVMConcHashBody;
+typedef struct MVMConcHashTable MVMConcHashTable;
+typedef struct MVMConcHashSlot MVMConcHashSlot;
+typedef struct MVMIntHash MVMIntHash;
+typedef struct MVMIntHashBody MVMIntHashBody;
+typedef struct MVMIntHashREPRData MVMIntHashREPRData;